@@ -1,4 +1,5 @@
 #include "Decode.hpp"
+#include "Limbs.hpp"
 #include <iostream>
 
 namespace decode {
@@ -9,35 +10,143 @@ namespace decode {
         std::cout << std::endl;
     }
 
-    std::vector<uint8_t> convert_base(std::vector<uint8_t> working, const int source, const int target) {
-        std::vector<uint8_t> remainder;
-        int sindex = 0;
-        const int looping = working.size() - 1;
-
-        while(sindex < working.size()) {
-            for(int i = sindex; i < looping; ++i) {
-                const uint8_t new_val = working[i] / target;
-                const uint8_t rem = working[i] % target;
-                working[i] = new_val;
-                working[i+1] = working[i+1] + (source * rem);
-
-                if(i == sindex && working[i] == 0) {
-                    ++sindex;
+    static void check_base(const int base) {
+        if(base < 2 || base > 36) {
+            throw std::invalid_argument("base must be between 2 and 36");
+        }
+    }
+
+    //bits per digit for power of two bases, 0 for everything else
+    static int digit_bits(const int base) {
+        return (base & (base - 1)) == 0 ? __builtin_ctz(base) : 0;
+    }
+
+    //the most digits of base that fit in one limb, and base to that power
+    static int chunk_digits(const int base, uint32_t& power) {
+        int k = 0;
+        uint64_t p = 1;
+        while(p * base <= 0xFFFFFFFFULL) {
+            p *= base;
+            ++k;
+        }
+
+        power = static_cast<uint32_t>(p);
+        return k;
+    }
+
+    //most significant first digits into little endian limbs, returns the limbs in use
+    static int digits_to_limbs(const uint8_t* digits, const int n, const int base, std::vector<uint32_t>& a) {
+        a.assign((static_cast<size_t>(n) * 6 / 32) + 2, 0);
+        const int bits = digit_bits(base);
+        if(bits != 0) {
+            int at = 0;
+            for(int i = n - 1; i >= 0; --i, at += bits) {
+                const uint64_t d = static_cast<uint64_t>(digits[i]) << (at % 32);
+                a[at / 32] |= static_cast<uint32_t>(d);
+                a[(at / 32) + 1] |= static_cast<uint32_t>(d >> 32);
+            }
+
+            return limbs::length(a.data(), static_cast<int>(a.size()));
+        }
+
+        //k digits at a time, a leading partial chunk first so the rest are whole
+        uint32_t power;
+        const int k = chunk_digits(base, power);
+        int used = 0;
+        int i = 0;
+        int take = n % k == 0 ? k : n % k;
+        while(i < n) {
+            uint32_t chunk = 0;
+            uint32_t scale = 1;
+            for(int j = 0; j < take; ++j, ++i) {
+                chunk = (chunk * base) + digits[i];
+                scale *= base;
+            }
+
+            const uint32_t carry = limbs::mul_1(a.data(), used, scale, chunk);
+            if(carry != 0) {
+                a[used++] = carry;
+            }
+
+            take = k;
+        }
+
+        return used;
+    }
+
+    //little endian limbs into most significant first digits, a is clobbered
+    //and zero comes back as a single 0 digit
+    static std::vector<uint8_t> limbs_to_digits(uint32_t* a, int used, const int base) {
+        std::vector<uint8_t> ret;
+        const int bits = digit_bits(base);
+        if(bits != 0) {
+            const int total = limbs::bit_length(a, used);
+            const uint32_t mask = base - 1;
+            for(int at = 0; at < total; at += bits) {
+                uint64_t window = a[at / 32];
+                if((at / 32) + 1 < used) {
+                    window |= static_cast<uint64_t>(a[(at / 32) + 1]) << 32;
+                }
+
+                ret.push_back(static_cast<uint8_t>((window >> (at % 32)) & mask));
+            }
+        }
+        else {
+            uint32_t power;
+            const int k = chunk_digits(base, power);
+            while(used > 0) {
+                uint32_t rem = limbs::divmod_1(a, a, used, power);
+                used = limbs::length(a, used);
+                for(int j = 0; j < k && (used > 0 || rem != 0); ++j) {
+                    ret.push_back(static_cast<uint8_t>(rem % base));
+                    rem /= base;
                 }
             }
+        }
 
-            const uint8_t new_val = working[looping] / target;
-            const uint8_t rem = working[looping] % target;
-            remainder.push_back(rem);
-            working[looping] = new_val;
+        if(ret.empty()) {
+            ret.push_back(0);
+        }
 
-            if(looping == sindex && working[looping] == 0) {
-                ++sindex;
+        std::reverse(ret.begin(), ret.end());
+        return ret;
+    }
+
+    //every pair of bases goes through binary limbs, power of two bases are
+    //regrouped bit by bit and the rest move a whole limb of digits per step
+    std::vector<uint8_t> convert_base(std::vector<uint8_t> working, const int source, const int target) {
+        check_base(source);
+        check_base(target);
+        if(working.empty()) {
+            return working;
+        }
+
+        for(const uint8_t d : working) {
+            if(d >= source) {
+                throw std::invalid_argument("digit is not valid for the base");
             }
         }
-        
-        std::reverse(remainder.begin(), remainder.end());
-        return remainder;
+
+        std::vector<uint32_t> a;
+        const int used = digits_to_limbs(working.data(), static_cast<int>(working.size()), source, a);
+        return limbs_to_digits(a.data(), used, target);
+    }
+
+    std::vector<uint8_t> bytes_to_digits(const uint8_t* bytes, const size_t n, const int target) {
+        check_base(target);
+        std::vector<uint32_t> a(limbs::count(static_cast<int>(n)) + 1);
+        limbs::load(a.data(), static_cast<int>(a.size()), bytes, static_cast<int>(n));
+        return limbs_to_digits(a.data(), limbs::length(a.data(), static_cast<int>(a.size())), target);
+    }
+
+    std::string bytes_str(const uint8_t* bytes, const size_t n, const int target) {
+        const std::vector<uint8_t> digits = bytes_to_digits(bytes, n, target);
+        std::string ret(digits.size(), '0');
+        for(size_t i = 0; i < digits.size(); ++i) {
+            ret[i] = to_char(digits[i]);
+        }
+
+        return ret;
     }
 
     std::vector<uint8_t> convert_base(const std::string& input, const int source, const int target) {
@@ -103,3 +212,200 @@ namespace decode {
     }
 
 }
+
+//The hex kernels pick SSSE3 or AVX2 at run time on x86-64, so they are used
+//without any -m flags on the build.
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define DECODE_HEX_X86 1
+#include <immintrin.h>
+#endif
+
+namespace decode {
+
+    static const char upper_hex[17] = "0123456789ABCDEF";
+    static const char lower_hex[17] = "0123456789abcdef";
+
+    static int hex_value(const char c) {
+        if(c >= '0' && c <= '9') return c - '0';
+        if(c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if(c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+#if defined(DECODE_HEX_X86)
+    static bool has_ssse3() {
+        static const bool supported = __builtin_cpu_supports("ssse3");
+        return supported;
+    }
+
+    static bool has_avx2() {
+        static const bool supported = __builtin_cpu_supports("avx2");
+        return supported;
+    }
+
+    //16 bytes to 32 characters, the bytes are reversed so the top one leads
+    __attribute__((target("ssse3")))
+    static void hex_encode_16(const uint8_t* src, char* out, const char* digits) {
+        const __m128i lut = _mm_loadu_si128(reinterpret_cast<const __m128i*>(digits));
+        const __m128i low_nibbles = _mm_set1_epi8(0x0F);
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+        v = _mm_shuffle_epi8(v, _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0));
+        const __m128i hi = _mm_and_si128(_mm_srli_epi16(v, 4), low_nibbles);
+        const __m128i lo = _mm_and_si128(v, low_nibbles);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_shuffle_epi8(lut, _mm_unpacklo_epi8(hi, lo)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16), _mm_shuffle_epi8(lut, _mm_unpackhi_epi8(hi, lo)));
+    }
+
+    //32 bytes to 64 characters, shuffles stay within 128 bit lanes so the
+    //lanes are swapped and regrouped around them
+    __attribute__((target("avx2")))
+    static void hex_encode_32(const uint8_t* src, char* out, const char* digits) {
+        const __m256i lut = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(digits)));
+        const __m256i low_nibbles = _mm256_set1_epi8(0x0F);
+        const __m256i reverse = _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+                                                 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+        v = _mm256_permute4x64_epi64(_mm256_shuffle_epi8(v, reverse), 0x4E);
+        const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_nibbles);
+        const __m256i lo = _mm256_and_si256(v, low_nibbles);
+        const __m256i a = _mm256_unpacklo_epi8(hi, lo);
+        const __m256i b = _mm256_unpackhi_epi8(hi, lo);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_shuffle_epi8(lut, _mm256_permute2x128_si256(a, b, 0x20)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 32), _mm256_shuffle_epi8(lut, _mm256_permute2x128_si256(a, b, 0x31)));
+    }
+
+    //nibble values of 16 characters, valid gets 0xFF for each hex digit
+    __attribute__((target("ssse3")))
+    static __m128i hex_nibbles(const __m128i c, __m128i& valid) {
+        const __m128i digit = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+        const __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+        const __m128i letter = _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+        const __m128i is_letter = _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(5)), letter);
+        valid = _mm_or_si128(is_digit, is_letter);
+        return _mm_or_si128(_mm_and_si128(is_digit, digit),
+                            _mm_and_si128(is_letter, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+    }
+
+    //32 characters to 16 bytes, the last character ends up in the low nibble of out[0]
+    __attribute__((target("ssse3")))
+    static bool hex_decode_16(const char* chars, uint8_t* out) {
+        __m128i valid_a, valid_b;
+        const __m128i a = hex_nibbles(_mm_loadu_si128(reinterpret_cast<const __m128i*>(chars)), valid_a);
+        const __m128i b = hex_nibbles(_mm_loadu_si128(reinterpret_cast<const __m128i*>(chars + 16)), valid_b);
+        if(_mm_movemask_epi8(_mm_and_si128(valid_a, valid_b)) != 0xFFFF) {
+            return false;
+        }
+
+        const __m128i weights = _mm_setr_epi8(16, 1, 16, 1, 16, 1, 16, 1, 16, 1, 16, 1, 16, 1, 16, 1);
+        const __m128i packed = _mm_packus_epi16(_mm_maddubs_epi16(a, weights), _mm_maddubs_epi16(b, weights));
+        const __m128i reversed = _mm_shuffle_epi8(packed, _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), reversed);
+        return true;
+    }
+#endif
+
+    void hex_encode(const uint8_t* bytes, const size_t n, char* out, const bool upper) {
+        const char* digits = upper ? upper_hex : lower_hex;
+        size_t done = 0;
+
+#if defined(DECODE_HEX_X86)
+        if(has_avx2()) {
+            for(; n - done >= 32; done += 32) {
+                hex_encode_32(bytes + n - done - 32, out + (2 * done), digits);
+            }
+        }
+
+        if(has_ssse3()) {
+            for(; n - done >= 16; done += 16) {
+                hex_encode_16(bytes + n - done - 16, out + (2 * done), digits);
+            }
+        }
+#endif
+
+        for(; done < n; ++done) {
+            const uint8_t b = bytes[n - done - 1];
+            out[2 * done] = digits[b >> 4];
+            out[(2 * done) + 1] = digits[b & 0xF];
+        }
+    }
+
+    bool hex_decode(const char* chars, const size_t n, uint8_t* out) {
+        size_t done = 0;
+
+#if defined(DECODE_HEX_X86)
+        if(has_ssse3()) {
+            for(; n - done >= 16; done += 16) {
+                if(!hex_decode_16(chars + (2 * (n - done)) - 32, out + done)) {
+                    return false;
+                }
+            }
+        }
+#endif
+
+        for(; done < n; ++done) {
+            const char* pair = chars + (2 * (n - done)) - 2;
+            const int hi = hex_value(pair[0]);
+            const int lo = hex_value(pair[1]);
+            if(hi < 0 || lo < 0) {
+                return false;
+            }
+
+            out[done] = static_cast<uint8_t>((hi << 4) | lo);
+        }
+
+        return true;
+    }
+
+    std::string hex_str(const uint8_t* bytes, const size_t n, const bool upper) {
+        size_t used = n;
+        while(used > 0 && bytes[used - 1] == 0) {
+            --used;
+        }
+
+        if(used == 0) {
+            return std::string("0");
+        }
+
+        std::string ret(2 * used, '0');
+        hex_encode(bytes, used, &ret[0], upper);
+        return ret[0] == '0' ? ret.substr(1) : ret;
+    }
+
+    bool hex_to_bytes(const char* input, const size_t length, uint8_t* out, const size_t n,
+                      bool& negative, size_t& significant) {
+        size_t i = 0;
+        negative = false;
+        if(length > 0 && (input[0] == '+' || input[0] == '-')) {
+            negative = input[0] == '-';
+            ++i;
+        }
+
+        while(i < length && input[i] == '0') {
+            ++i;
+        }
+
+        significant = length - i;
+        std::memset(out, 0, n);
+
+        //digits that do not fit are still checked, they just go nowhere
+        const size_t kept = std::min(significant, 2 * n);
+        for(; i < length - kept; ++i) {
+            if(hex_value(input[i]) < 0) {
+                return false;
+            }
+        }
+
+        //an odd leading digit is the low nibble of the top byte in use
+        if(kept % 2 == 1) {
+            const int top = hex_value(input[i]);
+            if(top < 0) {
+                return false;
+            }
+
+            out[kept / 2] = static_cast<uint8_t>(top);
+            ++i;
+        }
+
+        return hex_decode(input + i, kept / 2, out);
+    }
+}
@@ -0,0 +1,84 @@
+#include "FixnumFile.hpp"
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace fixnum {
+
+    static const char file_magic[8] = { 'F', 'I', 'X', 'N', 'U', 'M', 'A', '\0' };
+
+    FileHeader make_file_header(const uint32_t bits, const uint32_t stride) {
+        FileHeader header;
+        std::memset(&header, 0, sizeof(header));
+        std::memcpy(header.magic, file_magic, sizeof(file_magic));
+        header.version = file_version;
+        header.bits = bits;
+        header.stride = stride;
+        header.endianness = file_little_endian;
+        header.data_offset = file_data_offset;
+        return header;
+    }
+
+    void check_file_header(const FileHeader& header, const uint32_t bits, const uint32_t stride, const uint64_t file_size) {
+        if(std::memcmp(header.magic, file_magic, sizeof(file_magic)) != 0) {
+            throw std::runtime_error("not a fixnum file");
+        }
+
+        if(header.endianness != file_little_endian) {
+            throw std::runtime_error("fixnum file was written with a different byte order");
+        }
+
+        if(header.version != file_version) {
+            throw std::runtime_error("unsupported fixnum file version");
+        }
+
+        if(header.bits != bits || header.stride != stride) {
+            throw std::runtime_error("fixnum file holds values of a different width");
+        }
+
+        if(header.data_offset < sizeof(FileHeader) || header.data_offset > file_size ||
+           header.count > (file_size - header.data_offset) / stride) {
+            throw std::runtime_error("fixnum file is truncated");
+        }
+    }
+
+    MappedFile::MappedFile(const std::string& path) : _data(nullptr), _size(0) {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if(fd < 0) {
+            throw std::runtime_error("can't open " + path);
+        }
+
+        struct stat st;
+        if(::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("can't stat " + path);
+        }
+
+        _size = static_cast<uint64_t>(st.st_size);
+        if(_size > 0) {
+            void* mapped = ::mmap(nullptr, _size, PROT_READ, MAP_SHARED, fd, 0);
+            if(mapped == MAP_FAILED) {
+                ::close(fd);
+                throw std::runtime_error("can't map " + path);
+            }
+
+            _data = static_cast<const uint8_t*>(mapped);
+        }
+
+        //the mapping keeps its own reference to the file
+        ::close(fd);
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) : _data(other._data), _size(other._size) {
+        other._data = nullptr;
+        other._size = 0;
+    }
+
+    MappedFile::~MappedFile() {
+        if(_data != nullptr) {
+            ::munmap(const_cast<uint8_t*>(_data), _size);
+        }
+    }
+}
@@ -0,0 +1,444 @@
+#include "Limbs.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace limbs {
+
+    static void clear(uint32_t* a, const int n) {
+        for(int i = 0; i < n; ++i) {
+            a[i] = 0;
+        }
+    }
+
+    void load(uint32_t* dst, const int n, const uint8_t* src, const int bytes) {
+        clear(dst, n);
+        for(int i = 0; i < bytes && i < n * 4; ++i) {
+            dst[i / 4] |= static_cast<uint32_t>(src[i]) << (8 * (i % 4));
+        }
+    }
+
+    void store(uint8_t* dst, const int bytes, const uint32_t* src, const int n) {
+        for(int i = 0; i < bytes; ++i) {
+            dst[i] = (i / 4) < n ? static_cast<uint8_t>(src[i / 4] >> (8 * (i % 4))) : 0;
+        }
+    }
+
+    int length(const uint32_t* a, const int n) {
+        int i = n;
+        while(i > 0 && a[i-1] == 0) {
+            --i;
+        }
+
+        return i;
+    }
+
+    int bit_length(const uint32_t* a, const int n) {
+        const int len = length(a, n);
+        return len == 0 ? 0 : (len * 32) - leading_zeros(a[len-1]);
+    }
+
+    void mul(uint32_t* r, const int nr, const uint32_t* a, const int na, const uint32_t* b, const int nb) {
+        clear(r, nr);
+        const int la = length(a, na);
+        const int lb = length(b, nb);
+
+        for(int i = 0; i < la && i < nr; ++i) {
+            const uint64_t ai = a[i];
+            if(ai == 0) {
+                continue;
+            }
+
+            const int top = std::min(lb, nr - i);
+            uint64_t carry = 0;
+            int j;
+            for(j = 0; j < top; ++j) {
+                const uint64_t t = ai * b[j] + r[i+j] + carry;
+                r[i+j] = static_cast<uint32_t>(t);
+                carry = t >> 32;
+            }
+
+            if(i + j < nr) {
+                r[i+j] = static_cast<uint32_t>(carry);
+            }
+        }
+    }
+
+    void sqr(uint32_t* r, const int nr, const uint32_t* a, const int na) {
+        clear(r, nr);
+        const int la = length(a, na);
+
+        for(int i = 0; i < la && 2 * i + 1 < nr; ++i) {
+            const uint64_t ai = a[i];
+            uint64_t carry = 0;
+            int j;
+            for(j = i + 1; j < la && i + j < nr; ++j) {
+                const uint64_t t = ai * a[j] + r[i+j] + carry;
+                r[i+j] = static_cast<uint32_t>(t);
+                carry = t >> 32;
+            }
+
+            if(i + j < nr) {
+                r[i+j] = static_cast<uint32_t>(carry);
+            }
+        }
+
+        shl(r, nr, 1);
+
+        uint64_t carry = 0;
+        for(int i = 0; i < la && 2 * i < nr; ++i) {
+            const uint64_t sq = static_cast<uint64_t>(a[i]) * a[i];
+            uint64_t t = static_cast<uint64_t>(r[2*i]) + static_cast<uint32_t>(sq) + carry;
+            r[2*i] = static_cast<uint32_t>(t);
+            carry = t >> 32;
+
+            if(2 * i + 1 < nr) {
+                t = static_cast<uint64_t>(r[2*i+1]) + (sq >> 32) + carry;
+                r[2*i+1] = static_cast<uint32_t>(t);
+                carry = t >> 32;
+            }
+        }
+
+        for(int i = 2 * la; carry != 0 && i < nr; ++i) {
+            const uint64_t t = static_cast<uint64_t>(r[i]) + carry;
+            r[i] = static_cast<uint32_t>(t);
+            carry = t >> 32;
+        }
+    }
+
+    int cmp(const uint32_t* a, const uint32_t* b, const int n) {
+        for(int i = n - 1; i >= 0; --i) {
+            if(a[i] != b[i]) {
+                return a[i] < b[i] ? -1 : 1;
+            }
+        }
+
+        return 0;
+    }
+
+    bool is_zero(const uint32_t* a, const int n) {
+        return length(a, n) == 0;
+    }
+
+    uint32_t add(uint32_t* a, const uint32_t* b, const int n) {
+        uint64_t carry = 0;
+        for(int i = 0; i < n; ++i) {
+            const uint64_t t = static_cast<uint64_t>(a[i]) + b[i] + carry;
+            a[i] = static_cast<uint32_t>(t);
+            carry = t >> 32;
+        }
+
+        return static_cast<uint32_t>(carry);
+    }
+
+    uint32_t sub(uint32_t* a, const uint32_t* b, const int n) {
+        uint32_t borrow = 0;
+        for(int i = 0; i < n; ++i) {
+            const uint64_t t = static_cast<uint64_t>(a[i]) - b[i] - borrow;
+            a[i] = static_cast<uint32_t>(t);
+            borrow = (t >> 32) != 0 ? 1 : 0;
+        }
+
+        return borrow;
+    }
+
+    void shl(uint32_t* a, const int n, const int by) {
+        const int words = by / 32;
+        const int rest = by % 32;
+        for(int i = n - 1; i >= 0; --i) {
+            const int src = i - words;
+            uint32_t v = src >= 0 ? (a[src] << rest) : 0;
+            if(rest != 0 && src - 1 >= 0) {
+                v |= a[src - 1] >> (32 - rest);
+            }
+
+            a[i] = v;
+        }
+    }
+
+    void shr(uint32_t* a, const int n, const int by) {
+        const int words = by / 32;
+        const int rest = by % 32;
+        for(int i = 0; i < n; ++i) {
+            const int src = i + words;
+            uint32_t v = src < n ? (a[src] >> rest) : 0;
+            if(rest != 0 && src + 1 < n) {
+                v |= a[src + 1] << (32 - rest);
+            }
+
+            a[i] = v;
+        }
+    }
+
+    int trailing_zeros(const uint32_t* a, const int n) {
+        for(int i = 0; i < n; ++i) {
+            if(a[i] != 0) {
+                int bit = 0;
+                while(((a[i] >> bit) & 1) == 0) {
+                    ++bit;
+                }
+
+                return (i * 32) + bit;
+            }
+        }
+
+        return n * 32;
+    }
+
+    int leading_zeros(const uint32_t word) {
+        if(word == 0) {
+            return 32;
+        }
+
+        int count = 0;
+        uint32_t w = word;
+        while((w & 0x80000000u) == 0) {
+            w <<= 1;
+            ++count;
+        }
+
+        return count;
+    }
+
+    uint32_t mul_1(uint32_t* a, const int n, const uint32_t m, const uint32_t carry_in) {
+        uint64_t carry = carry_in;
+        for(int i = 0; i < n; ++i) {
+            const uint64_t t = static_cast<uint64_t>(a[i]) * m + carry;
+            a[i] = static_cast<uint32_t>(t);
+            carry = t >> 32;
+        }
+
+        return static_cast<uint32_t>(carry);
+    }
+
+    uint32_t divmod_1(uint32_t* q, const uint32_t* a, const int n, const uint32_t d) {
+        uint64_t rem = 0;
+        for(int i = n - 1; i >= 0; --i) {
+            const uint64_t cur = (rem << 32) | a[i];
+            q[i] = static_cast<uint32_t>(cur / d);
+            rem = cur % d;
+        }
+
+        return static_cast<uint32_t>(rem);
+    }
+
+    void divmod(uint32_t* q, uint32_t* r, const uint32_t* a, const int na, const uint32_t* b, const int nb, uint32_t* scratch) {
+        const int m = length(a, na);
+        const int n = length(b, nb);
+        clear(q, na);
+
+        if(m < n) {
+            clear(r, nb);
+            std::copy(a, a + m, r);
+            return;
+        }
+
+        if(n == 1) {
+            clear(r, nb);
+            r[0] = divmod_1(q, a, m, b[0]);
+            return;
+        }
+
+        const int s = leading_zeros(b[n-1]);
+        uint32_t* vn = scratch;
+        uint32_t* un = scratch + n;
+
+        for(int i = n - 1; i > 0; --i) {
+            vn[i] = s == 0 ? b[i] : (b[i] << s) | (b[i-1] >> (32 - s));
+        }
+        vn[0] = b[0] << s;
+
+        un[m] = s == 0 ? 0 : a[m-1] >> (32 - s);
+        for(int i = m - 1; i > 0; --i) {
+            un[i] = s == 0 ? a[i] : (a[i] << s) | (a[i-1] >> (32 - s));
+        }
+        un[0] = a[0] << s;
+
+        const uint64_t base = 1ULL << 32;
+        for(int j = m - n; j >= 0; --j) {
+            const uint64_t num = (static_cast<uint64_t>(un[j+n]) << 32) | un[j+n-1];
+            uint64_t qhat = num / vn[n-1];
+            uint64_t rhat = num % vn[n-1];
+
+            while(qhat >= base || qhat * vn[n-2] > ((rhat << 32) | un[j+n-2])) {
+                --qhat;
+                rhat += vn[n-1];
+                if(rhat >= base) {
+                    break;
+                }
+            }
+
+            int64_t borrow = 0;
+            int64_t t;
+            for(int i = 0; i < n; ++i) {
+                const uint64_t p = qhat * vn[i];
+                t = static_cast<int64_t>(un[i+j]) - borrow - static_cast<int64_t>(p & 0xFFFFFFFFu);
+                un[i+j] = static_cast<uint32_t>(t);
+                borrow = static_cast<int64_t>(p >> 32) - (t >> 32);
+            }
+
+            t = static_cast<int64_t>(un[j+n]) - borrow;
+            un[j+n] = static_cast<uint32_t>(t);
+
+            q[j] = static_cast<uint32_t>(qhat);
+            if(t < 0) {
+                //qhat was one too large, add the divisor back
+                --q[j];
+                uint64_t carry = 0;
+                for(int i = 0; i < n; ++i) {
+                    const uint64_t sum = static_cast<uint64_t>(un[i+j]) + vn[i] + carry;
+                    un[i+j] = static_cast<uint32_t>(sum);
+                    carry = sum >> 32;
+                }
+
+                un[j+n] += static_cast<uint32_t>(carry);
+            }
+        }
+
+        clear(r, nb);
+        for(int i = 0; i < n; ++i) {
+            r[i] = s == 0 ? un[i] : (un[i] >> s) | (un[i+1] << (32 - s));
+        }
+    }
+
+    static uint64_t to_word(const uint32_t* a, const int n) {
+        return n > 1 ? (static_cast<uint64_t>(a[1]) << 32) | a[0] : a[0];
+    }
+
+    static uint64_t word_gcd(uint64_t a, uint64_t b) {
+        while(b != 0) {
+            const uint64_t t = a % b;
+            a = b;
+            b = t;
+        }
+
+        return a;
+    }
+
+    void binary_gcd(uint32_t* a, uint32_t* b, const int n) {
+        if(is_zero(a, n)) {
+            std::copy(b, b + n, a);
+            return;
+        }
+
+        if(is_zero(b, n)) {
+            return;
+        }
+
+        const int za = trailing_zeros(a, n);
+        const int zb = trailing_zeros(b, n);
+        const int shift = std::min(za, zb);
+        shr(a, n, za);
+        shr(b, n, zb);
+
+        //both odd from here on, the difference of two odd values is even
+        for(;;) {
+            const int len = std::max(length(a, n), length(b, n));
+            if(len <= 2) {
+                const uint64_t g = word_gcd(to_word(a, n), to_word(b, n));
+                clear(a, n);
+                a[0] = static_cast<uint32_t>(g);
+                if(n > 1) {
+                    a[1] = static_cast<uint32_t>(g >> 32);
+                }
+
+                break;
+            }
+
+            const int c = cmp(a, b, len);
+            if(c == 0) {
+                break;
+            }
+
+            uint32_t* larger = c > 0 ? a : b;
+            const uint32_t* smaller = c > 0 ? b : a;
+            sub(larger, smaller, len);
+            shr(larger, len, trailing_zeros(larger, len));
+        }
+
+        shl(a, n, shift);
+    }
+
+    //30 bits keeps every cofactor product inside an int64_t
+    static const int lehmer_bits = 30;
+
+    static int64_t window(const uint32_t* a, const int n, const int shift) {
+        const int index = shift / 32;
+        uint64_t w = a[index];
+        if(index + 1 < n) {
+            w |= static_cast<uint64_t>(a[index + 1]) << 32;
+        }
+
+        return static_cast<int64_t>((w >> (shift % 32)) & ((1ULL << lehmer_bits) - 1));
+    }
+
+    static void combine(uint32_t* out, const int64_t ca, const uint32_t* a, const int64_t cb, const uint32_t* b, const int n) {
+        int64_t carry = 0;
+        for(int i = 0; i < n; ++i) {
+            const int64_t t = ca * static_cast<int64_t>(a[i]) + cb * static_cast<int64_t>(b[i]) + carry;
+            out[i] = static_cast<uint32_t>(t);
+            carry = t >> 32;
+        }
+    }
+
+    void lehmer_gcd(uint32_t* a, uint32_t* b, const int n, uint32_t* scratch) {
+        //x, y, r and t rotate through a, b and the first two scratch rows
+        uint32_t* x = a;
+        uint32_t* y = b;
+        uint32_t* r = scratch;
+        uint32_t* t = scratch + n;
+        uint32_t* q = scratch + (2 * n);
+        uint32_t* rest = scratch + (3 * n);
+
+        if(cmp(x, y, n) < 0) {
+            std::swap(x, y);
+        }
+
+        while(length(y, n) > 2) {
+            const int lx = length(x, n);
+            const int top_bits = (lx * 32) - leading_zeros(x[lx-1]);
+            const int shift = top_bits - lehmer_bits;
+
+            int64_t xhat = window(x, n, shift);
+            int64_t yhat = window(y, n, shift);
+            int64_t ca = 1, cb = 0, cc = 0, cd = 1;
+
+            //single limb quotients, valid for as long as both bounds agree
+            while((yhat + cc) != 0 && (yhat + cd) != 0) {
+                const int64_t q1 = (xhat + ca) / (yhat + cc);
+                const int64_t q2 = (xhat + cb) / (yhat + cd);
+                if(q1 != q2) {
+                    break;
+                }
+
+                int64_t tmp = ca - q1 * cc;
+                ca = cc;
+                cc = tmp;
+                tmp = cb - q1 * cd;
+                cb = cd;
+                cd = tmp;
+                tmp = xhat - q1 * yhat;
+                xhat = yhat;
+                yhat = tmp;
+            }
+
+            if(cb == 0) {
+                divmod(q, r, x, n, y, n, rest);
+                uint32_t* const old = x;
+                x = y;
+                y = r;
+                r = old;
+            }
+            else {
+                combine(t, ca, x, cb, y, n);
+                combine(r, cc, x, cd, y, n);
+                std::swap(x, t);
+                std::swap(y, r);
+            }
+        }
+
+        binary_gcd(x, y, n);
+        if(x != a) {
+            std::copy(x, x + n, a);
+        }
+    }
+}
@@ -0,0 +1,85 @@
+#ifndef ALLOCATOR_HPP_1a9ea8365f9b66b1405a94f7c9d09167e7a4384c
+#define ALLOCATOR_HPP_1a9ea8365f9b66b1405a94f7c9d09167e7a4384c
+
+#include "Fixnum.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <vector>
+
+namespace fixnum {
+
+    constexpr size_t cache_line = 64;
+
+    //over allocates and keeps the pointer operator new gave back just below
+    //the aligned block, align must be a power of two
+    inline void* _aligned_allocate(const size_t size, const size_t align) {
+        void* raw = ::operator new(size + align + sizeof(void*));
+        const uintptr_t at = reinterpret_cast<uintptr_t>(raw) + sizeof(void*);
+        void** aligned = reinterpret_cast<void**>((at + align - 1) & ~static_cast<uintptr_t>(align - 1));
+        aligned[-1] = raw;
+        return aligned;
+    }
+
+    inline void _aligned_deallocate(void* p) {
+        if(p != nullptr) {
+            ::operator delete(static_cast<void**>(p)[-1]);
+        }
+    }
+
+    //Hands out blocks starting on an Align boundary. An array of
+    //Fixnum<N, AlignedStorage<64>> then has every value on its own lines,
+    //and packed values whose size divides Align never straddle a line.
+    template<typename T, size_t Align = cache_line>
+    class CacheLineAllocator {
+    public:
+        static_assert((Align & (Align - 1)) == 0, "Align must be a power of two");
+        static constexpr size_t alignment = Align < alignof(T) ? alignof(T) : Align;
+
+        using value_type = T;
+
+        template<typename U>
+        struct rebind {
+            using other = CacheLineAllocator<U, Align>;
+        };
+
+        CacheLineAllocator() {}
+
+        template<typename U>
+        CacheLineAllocator(const CacheLineAllocator<U, Align>&) {}
+
+        T* allocate(const size_t n) {
+            if(n > std::numeric_limits<size_t>::max() / sizeof(T)) {
+                throw std::bad_alloc();
+            }
+
+            return static_cast<T*>(_aligned_allocate(n * sizeof(T), alignment));
+        }
+
+        void deallocate(T* p, const size_t) {
+            _aligned_deallocate(p);
+        }
+    };
+
+    template<typename T, typename U, size_t Align>
+    bool operator==(const CacheLineAllocator<T, Align>&, const CacheLineAllocator<U, Align>&) {
+        return true;
+    }
+
+    template<typename T, typename U, size_t Align>
+    bool operator!=(const CacheLineAllocator<T, Align>&, const CacheLineAllocator<U, Align>&) {
+        return false;
+    }
+
+    //the hot array layout: cache line aligned values in a cache line aligned block
+    template<size_t N, typename Storage = AlignedStorage<cache_line>>
+    using AlignedFixnumVector = std::vector<Fixnum<N, Storage>, CacheLineAllocator<Fixnum<N, Storage>>>;
+
+    inline bool is_aligned(const void* p, const size_t align) {
+        return (reinterpret_cast<uintptr_t>(p) & (align - 1)) == 0;
+    }
+}
+
+#endif
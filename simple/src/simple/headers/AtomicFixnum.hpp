@@ -0,0 +1,418 @@
+#ifndef ATOMICFIXNUM_HPP_1f38c2c0df3e70c368aea8cc6bf4eb99e49a05fc
+#define ATOMICFIXNUM_HPP_1f38c2c0df3e70c368aea8cc6bf4eb99e49a05fc
+
+#include "Fixnum.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define FIXNUM_HAS_CAS16 1
+#else
+#define FIXNUM_HAS_CAS16 0
+#endif
+
+namespace fixnum {
+
+    //busy waits briefly, then gives the core away in case the holder was descheduled
+    inline void _spin_pause(const unsigned spins) {
+#if defined(__SSE2__)
+        if(spins < 64) {
+            _mm_pause();
+            return;
+        }
+#endif
+        (void) spins;
+        std::this_thread::yield();
+    }
+
+    //w += v or w -= v a word at a time, wrapped to N bits like Fixnum
+    template<size_t N>
+    void _add_words(uint64_t* w, const uint64_t* v, const int words, const bool subtract) {
+        uint64_t carry = 0;
+        for(int i = 0; i < words; ++i) {
+            const uint64_t a = w[i];
+            const uint64_t b = v[i] + carry;
+            const uint64_t wrapped = b < carry ? 1 : 0;
+            w[i] = subtract ? a - b : a + b;
+            carry = wrapped | (subtract ? (a < b ? 1 : 0) : (w[i] < a ? 1 : 0));
+        }
+
+        if(N % 64 != 0) {
+            w[words - 1] &= (1ULL << (N % 64)) - 1;
+        }
+    }
+
+    //Up to 64 bits live in one std::atomic word. Full width values use the
+    //hardware add, narrower ones loop on compare exchange so the bits above
+    //N stay clear.
+    template<size_t N>
+    class _NativeAtomic {
+    public:
+        using F = Fixnum<N>;
+        using U = typename std::conditional<(F::bytes <= 1), uint8_t,
+                  typename std::conditional<(F::bytes <= 2), uint16_t,
+                  typename std::conditional<(F::bytes <= 4), uint32_t, uint64_t>::type>::type>::type;
+
+        static constexpr bool lock_free = true;
+        static constexpr bool full_width = N == 8 * sizeof(U);
+
+        explicit _NativeAtomic(const F& f) : _word(_bits(f)) {}
+
+        F load() const {
+            return _value(_word.load());
+        }
+
+        void store(const F& f) {
+            _word.store(_bits(f));
+        }
+
+        bool compare_exchange(F& expected, const F& desired) {
+            U e = _bits(expected);
+            const bool ok = _word.compare_exchange_strong(e, _bits(desired));
+            expected = _value(e);
+            return ok;
+        }
+
+        F fetch_add(const F& f) {
+            return full_width ? _value(_word.fetch_add(_bits(f))) : update([&](F& v) { v += f; });
+        }
+
+        F fetch_sub(const F& f) {
+            return full_width ? _value(_word.fetch_sub(_bits(f))) : update([&](F& v) { v -= f; });
+        }
+
+        F fetch_or(const F& f) {
+            return _value(_word.fetch_or(_bits(f)));
+        }
+
+        template<typename Op>
+        F update(Op op) {
+            U seen = _word.load();
+            for(;;) {
+                F next = _value(seen);
+                op(next);
+                if(_word.compare_exchange_weak(seen, _bits(next))) {
+                    return _value(seen);
+                }
+            }
+        }
+
+    private:
+        static U _bits(const F& f) {
+            U u = 0;
+            std::memcpy(&u, f.data(), F::bytes);
+            return u;
+        }
+
+        static F _value(const U u) {
+            F f;
+            std::memcpy(f.data(), &u, F::bytes);
+            return f;
+        }
+
+        std::atomic<U> _word;
+    };
+
+#if FIXNUM_HAS_CAS16
+    struct alignas(16) _DoubleWord {
+        uint64_t lo;
+        uint64_t hi;
+    };
+
+    //lock cmpxchg16b, expected is refreshed with what was there on failure
+    inline bool _cas16(_DoubleWord* target, _DoubleWord& expected, const _DoubleWord& desired) {
+        bool ok;
+        __asm__ __volatile__("lock cmpxchg16b %[target]"
+                             : [target] "+m"(*target), "+a"(expected.lo), "+d"(expected.hi), "=@ccz"(ok)
+                             : "b"(desired.lo), "c"(desired.hi)
+                             : "memory");
+        return ok;
+    }
+
+    //65 to 128 bits in one 16 byte word updated with cmpxchg16b, loads are a
+    //compare exchange that swaps the value for itself
+    template<size_t N>
+    class _DoubleWordAtomic {
+    public:
+        using F = Fixnum<N>;
+
+        static constexpr bool lock_free = true;
+
+        explicit _DoubleWordAtomic(const F& f) : _word(_bits(f)) {}
+
+        F load() const {
+            _DoubleWord seen = { 0, 0 };
+            _cas16(&_word, seen, seen);
+            return _value(seen);
+        }
+
+        void store(const F& f) {
+            update([&](F& v) { v = f; });
+        }
+
+        bool compare_exchange(F& expected, const F& desired) {
+            _DoubleWord e = _bits(expected);
+            const bool ok = _cas16(&_word, e, _bits(desired));
+            expected = _value(e);
+            return ok;
+        }
+
+        F fetch_add(const F& f) {
+            const _DoubleWord v = _bits(f);
+            return _value(update_words([&](uint64_t* w) { _add_words<N>(w, &v.lo, 2, false); }));
+        }
+
+        F fetch_sub(const F& f) {
+            const _DoubleWord v = _bits(f);
+            return _value(update_words([&](uint64_t* w) { _add_words<N>(w, &v.lo, 2, true); }));
+        }
+
+        F fetch_or(const F& f) {
+            const _DoubleWord v = _bits(f);
+            return _value(update_words([&](uint64_t* w) { w[0] |= v.lo; w[1] |= v.hi; }));
+        }
+
+        template<typename Op>
+        F update(Op op) {
+            return _value(update_words([&](uint64_t* w) {
+                F next = _value(_DoubleWord { w[0], w[1] });
+                op(next);
+                const _DoubleWord bits = _bits(next);
+                w[0] = bits.lo;
+                w[1] = bits.hi;
+            }));
+        }
+
+        //the halves are read separately as a first guess, a torn pair just
+        //fails the exchange and comes back whole
+        template<typename Op>
+        _DoubleWord update_words(Op op) {
+            _DoubleWord seen = { __atomic_load_n(&_word.lo, __ATOMIC_RELAXED), __atomic_load_n(&_word.hi, __ATOMIC_RELAXED) };
+            for(;;) {
+                _DoubleWord next = seen;
+                op(&next.lo);
+                const _DoubleWord old = seen;
+                if(_cas16(&_word, seen, next)) {
+                    return old;
+                }
+            }
+        }
+
+    private:
+        static _DoubleWord _bits(const F& f) {
+            _DoubleWord w = { 0, 0 };
+            std::memcpy(&w, f.data(), F::bytes);
+            return w;
+        }
+
+        static F _value(const _DoubleWord& w) {
+            F f;
+            std::memcpy(f.data(), &w, F::bytes);
+            return f;
+        }
+
+        mutable _DoubleWord _word;
+    };
+#endif
+
+    //Wider values sit behind a sequence lock. Writers take turns by making
+    //the sequence odd, readers copy the words and retry if the sequence moved
+    //under them, so loads never block a writer.
+    template<size_t N>
+    class _SeqlockAtomic {
+    public:
+        using F = Fixnum<N>;
+
+        static constexpr bool lock_free = false;
+        static constexpr int words = (F::bytes + 7) / 8;
+
+        explicit _SeqlockAtomic(const F& f) : _sequence(0) {
+            uint64_t w[words];
+            _bits(f, w);
+            for(int i = 0; i < words; ++i) {
+                _words[i].store(w[i], std::memory_order_relaxed);
+            }
+        }
+
+        F load() const {
+            uint64_t w[words];
+            for(unsigned spins = 0;; ++spins) {
+                const uint64_t before = _sequence.load(std::memory_order_acquire);
+                if((before & 1) == 0) {
+                    for(int i = 0; i < words; ++i) {
+                        w[i] = _words[i].load(std::memory_order_relaxed);
+                    }
+
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if(_sequence.load(std::memory_order_relaxed) == before) {
+                        return _value(w);
+                    }
+                }
+
+                _spin_pause(spins);
+            }
+        }
+
+        void store(const F& f) {
+            update([&](F& v) { v = f; });
+        }
+
+        bool compare_exchange(F& expected, const F& desired) {
+            bool ok = false;
+            const F old = update([&](F& v) {
+                ok = v == expected;
+                if(ok) {
+                    v = desired;
+                }
+            });
+
+            expected = old;
+            return ok;
+        }
+
+        F fetch_add(const F& f) {
+            uint64_t v[words];
+            _bits(f, v);
+            return update_words([&](uint64_t* w) { _add_words<N>(w, v, words, false); });
+        }
+
+        F fetch_sub(const F& f) {
+            uint64_t v[words];
+            _bits(f, v);
+            return update_words([&](uint64_t* w) { _add_words<N>(w, v, words, true); });
+        }
+
+        F fetch_or(const F& f) {
+            uint64_t v[words];
+            _bits(f, v);
+            return update_words([&](uint64_t* w) {
+                for(int i = 0; i < words; ++i) {
+                    w[i] |= v[i];
+                }
+            });
+        }
+
+        template<typename Op>
+        F update(Op op) {
+            return update_words([&](uint64_t* w) {
+                F next = _value(w);
+                op(next);
+                _bits(next, w);
+            });
+        }
+
+        template<typename Op>
+        F update_words(Op op) {
+            const uint64_t locked = _lock();
+            uint64_t w[words];
+            for(int i = 0; i < words; ++i) {
+                w[i] = _words[i].load(std::memory_order_relaxed);
+            }
+
+            const F old = _value(w);
+            op(w);
+            for(int i = 0; i < words; ++i) {
+                _words[i].store(w[i], std::memory_order_relaxed);
+            }
+
+            _sequence.store(locked + 1, std::memory_order_release);
+            return old;
+        }
+
+    private:
+        uint64_t _lock() {
+            uint64_t seen = _sequence.load(std::memory_order_relaxed);
+            for(unsigned spins = 0;; ++spins) {
+                if((seen & 1) == 0 && _sequence.compare_exchange_weak(seen, seen + 1, std::memory_order_acquire)) {
+                    std::atomic_thread_fence(std::memory_order_release);
+                    return seen + 1;
+                }
+
+                _spin_pause(spins);
+                seen = _sequence.load(std::memory_order_relaxed);
+            }
+        }
+
+        static void _bits(const F& f, uint64_t* w) {
+            w[words - 1] = 0;
+            std::memcpy(w, f.data(), F::bytes);
+        }
+
+        static F _value(const uint64_t* w) {
+            F f;
+            std::memcpy(f.data(), w, F::bytes);
+            return f;
+        }
+
+        std::atomic<uint64_t> _sequence;
+        std::atomic<uint64_t> _words[words];
+    };
+
+    template<size_t N>
+    using _AtomicStorage = typename std::conditional<(N <= 64), _NativeAtomic<N>,
+#if FIXNUM_HAS_CAS16
+                           typename std::conditional<(N <= 128), _DoubleWordAtomic<N>, _SeqlockAtomic<N>>::type
+#else
+                           _SeqlockAtomic<N>
+#endif
+                           >::type;
+
+    //Fixnum<N> shared between threads. Loads are at least acquire and every
+    //write is at least release, so a load sees one whole stored value and
+    //what was written before it. Wider values give no single total order
+    //the way seq_cst does. The fetch_ operations return the value from before.
+    template<size_t N>
+    class AtomicFixnum {
+    public:
+        static constexpr bool is_always_lock_free = _AtomicStorage<N>::lock_free;
+
+        AtomicFixnum() : _storage(Fixnum<N>(0)) {}
+
+        explicit AtomicFixnum(const Fixnum<N>& f) : _storage(f) {}
+
+        AtomicFixnum(const AtomicFixnum&) = delete;
+        AtomicFixnum& operator=(const AtomicFixnum&) = delete;
+
+        Fixnum<N> load() const {
+            return _storage.load();
+        }
+
+        void store(const Fixnum<N>& f) {
+            _storage.store(f);
+        }
+
+        Fixnum<N> exchange(const Fixnum<N>& f) {
+            return _storage.update([&](Fixnum<N>& v) { v = f; });
+        }
+
+        //strong, expected is set to the current value when it fails
+        bool compare_exchange(Fixnum<N>& expected, const Fixnum<N>& desired) {
+            return _storage.compare_exchange(expected, desired);
+        }
+
+        Fixnum<N> fetch_add(const Fixnum<N>& f) {
+            return _storage.fetch_add(f);
+        }
+
+        Fixnum<N> fetch_sub(const Fixnum<N>& f) {
+            return _storage.fetch_sub(f);
+        }
+
+        Fixnum<N> fetch_or(const Fixnum<N>& f) {
+            return _storage.fetch_or(f);
+        }
+
+    private:
+        _AtomicStorage<N> _storage;
+    };
+}
+
+#endif
@@ -0,0 +1,153 @@
+#ifndef BYTES_HPP_f15426296bf05e41358e2edd51e1ff29a3c14d66
+#define BYTES_HPP_f15426296bf05e41358e2edd51e1ff29a3c14d66
+
+#include "Fixnum.hpp"
+#include "Span.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+namespace fixnum {
+
+    inline uint64_t _bswap_64(const uint64_t v) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_bswap64(v);
+#else
+        uint64_t r = 0;
+        for(int i = 0; i < 8; ++i) {
+            r = (r << 8) | ((v >> (i * 8)) & 0xFF);
+        }
+        return r;
+#endif
+    }
+
+    //dst = src with the byte order reversed, eight bytes at a time from both ends
+    inline void _reverse_bytes(uint8_t* dst, const uint8_t* src, const size_t length) {
+        size_t i = 0;
+        for(; i + 8 <= length; i += 8) {
+            uint64_t word;
+            std::memcpy(&word, src + length - i - 8, 8);
+            word = _bswap_64(word);
+            std::memcpy(dst + i, &word, 8);
+        }
+
+        for(; i < length; ++i) {
+            dst[i] = src[length - i - 1];
+        }
+    }
+
+    template<size_t N>
+    void _check_byte_length(const size_t length) {
+        if(length > static_cast<size_t>(Fixnum<N>::bytes)) {
+            throw std::overflow_error("more bytes than fit in fixnum");
+        }
+    }
+
+    //shorter inputs are zero extended, bits above N in the top byte are dropped
+    template<size_t N>
+    Fixnum<N> from_bytes_le(const uint8_t* src, const size_t length) {
+        _check_byte_length<N>(length);
+        Fixnum<N> ret;
+        std::memcpy(ret.data(), src, length);
+        ret.data()[Fixnum<N>::top_index] &= Fixnum<N>::top_mask;
+        return ret;
+    }
+
+    template<size_t N>
+    Fixnum<N> from_bytes_be(const uint8_t* src, const size_t length) {
+        _check_byte_length<N>(length);
+        Fixnum<N> ret;
+        _reverse_bytes(ret.data(), src, length);
+        ret.data()[Fixnum<N>::top_index] &= Fixnum<N>::top_mask;
+        return ret;
+    }
+
+    template<size_t N>
+    Fixnum<N> from_bytes_le(Span<const uint8_t> src) {
+        return from_bytes_le<N>(src.data(), src.size());
+    }
+
+    template<size_t N>
+    Fixnum<N> from_bytes_be(Span<const uint8_t> src) {
+        return from_bytes_be<N>(src.data(), src.size());
+    }
+
+    //dst receives exactly Fixnum<N>::bytes bytes
+    template<size_t N>
+    void to_bytes_le(const Fixnum<N>& f, uint8_t* dst) {
+        std::memcpy(dst, f.data(), Fixnum<N>::bytes);
+    }
+
+    template<size_t N>
+    void to_bytes_be(const Fixnum<N>& f, uint8_t* dst) {
+        _reverse_bytes(dst, f.data(), Fixnum<N>::bytes);
+    }
+
+    template<size_t N>
+    void _check_byte_span(const Span<uint8_t> dst) {
+        if(dst.size() < static_cast<size_t>(Fixnum<N>::bytes)) {
+            throw std::overflow_error("not enough room for fixnum bytes");
+        }
+    }
+
+    template<size_t N>
+    void to_bytes_le(const Fixnum<N>& f, Span<uint8_t> dst) {
+        _check_byte_span<N>(dst);
+        to_bytes_le(f, dst.data());
+    }
+
+    template<size_t N>
+    void to_bytes_be(const Fixnum<N>& f, Span<uint8_t> dst) {
+        _check_byte_span<N>(dst);
+        to_bytes_be(f, dst.data());
+    }
+
+    //bulk forms read or write out.size() packed values of Fixnum<N>::bytes each
+    template<size_t N>
+    void from_bytes_le(const uint8_t* src, Span<Fixnum<N>> out) {
+        const int bytes = Fixnum<N>::bytes;
+        if(sizeof(Fixnum<N>) == bytes) {
+            std::memcpy(static_cast<void*>(out.data()), src, out.size() * bytes);
+            if(Fixnum<N>::top_mask != 0xFF) {
+                for(Fixnum<N>& f : out) {
+                    f.data()[Fixnum<N>::top_index] &= Fixnum<N>::top_mask;
+                }
+            }
+            return;
+        }
+
+        for(size_t i = 0; i < out.size(); ++i) {
+            out[i] = from_bytes_le<N>(src + (i * bytes), bytes);
+        }
+    }
+
+    template<size_t N>
+    void from_bytes_be(const uint8_t* src, Span<Fixnum<N>> out) {
+        for(size_t i = 0; i < out.size(); ++i) {
+            out[i] = from_bytes_be<N>(src + (i * Fixnum<N>::bytes), Fixnum<N>::bytes);
+        }
+    }
+
+    template<size_t N>
+    void to_bytes_le(Span<const Fixnum<N>> values, uint8_t* dst) {
+        const int bytes = Fixnum<N>::bytes;
+        if(sizeof(Fixnum<N>) == bytes) {
+            std::memcpy(dst, static_cast<const void*>(values.data()), values.size() * bytes);
+            return;
+        }
+
+        for(size_t i = 0; i < values.size(); ++i) {
+            to_bytes_le(values[i], dst + (i * bytes));
+        }
+    }
+
+    template<size_t N>
+    void to_bytes_be(Span<const Fixnum<N>> values, uint8_t* dst) {
+        for(size_t i = 0; i < values.size(); ++i) {
+            to_bytes_be(values[i], dst + (i * Fixnum<N>::bytes));
+        }
+    }
+}
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef DECODE_HPP_b2c9755d6a5d964a2449a7f46768f74f7ccf28da
 #define DECODE_HPP_b2c9755d6a5d964a2449a7f46768f74f7ccf28da
 
+#include <cstdint>
+#include <cstring>
 #include <string>
 #include <vector>
 #include <stdexcept>
@@ -8,6 +10,10 @@
 #include <string.h>
 #include <iostream>
 
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
 namespace decode {
 
     std::vector<uint8_t> convert_base(std::vector<uint8_t> working, const int source, const int target);
@@ -111,100 +117,46 @@ namespace decode {
         return working;
     }
         
+    //digit values 0 to 35 as '0' to '9' then 'A' to 'Z'
     constexpr char to_char(const uint8_t val) {
-        switch(val) {
-        case 0: return '0';
-        case 1: return '1';
-        case 2: return '2';
-        case 3: return '3';
-        case 4: return '4';
-        case 5: return '5';
-        case 6: return '6';
-        case 7: return '7';
-        case 8: return '8';
-        case 9: return '9';
-        case 10: return 'A';
-        case 11: return 'B';
-        case 12: return 'C';
-        case 13: return 'D';
-        case 14: return 'E';
-        case 15: return 'F';
-        default:
+        if(val < 10) {
+            return static_cast<char>('0' + val);
+        }
+        else if(val < 36) {
+            return static_cast<char>('A' + (val - 10));
+        }
+        else {
             throw std::out_of_range("invalid input for char digit");
         }
     }
 
+    //digits of the little endian value in bytes, most significant first,
+    //a single 0 digit for zero
+    std::vector<uint8_t> bytes_to_digits(const uint8_t* bytes, const size_t n, const int target);
+    std::string bytes_str(const uint8_t* bytes, const size_t n, const int target);
+
+    //N little endian hex digits, one per byte
     template<size_t N>
     std::string convert_pos_str(uint8_t* pos_hex, const int target) {
-        std::string ret;
-        
-        int sindex;
-        for(sindex = N - 1; sindex >= 0; --sindex) {
-            if(pos_hex[sindex] != 0) {
-                break;
-            }
+        uint8_t bytes[(N + 1) / 2] = { 0 };
+        for(size_t i = 0; i < N; ++i) {
+            bytes[i / 2] |= static_cast<uint8_t>(pos_hex[i] << (4 * (i % 2)));
         }
 
-        while(sindex >= 0) {
-            for(int i = sindex; i > 0; --i) {
-                const uint8_t new_val = pos_hex[i] / target;
-                const uint8_t rem = pos_hex[i] % target;
-                pos_hex[i] = new_val;
-                pos_hex[i-1] = pos_hex[i-1] + (16 * rem);
-
-                if(i == sindex && pos_hex[i] == 0) {
-                    --sindex;
-                }
-            }
-            
-            const uint8_t new_val = pos_hex[0] / target;
-            const uint8_t rem = pos_hex[0] % target;
-            
-            ret.append(1, to_char(rem));
-            pos_hex[0] = new_val;
-
-            if(0 == sindex && pos_hex[0] == 0) {
-                --sindex;
-            }
-        }
-
-        if(ret.empty()) {
-            return std::string("0");
-        }
-
-        std::reverse(ret.begin(), ret.end());
-        return ret;
+        return bytes_str(bytes, sizeof(bytes), target);
     }
 
     constexpr uint8_t convert_char(const char c) {
-        uint8_t val = 0;
-        switch(c) {
-        case '0':
-        case '1':
-        case '2':
-        case '3':
-        case '4':
-        case '5':
-        case '6':
-        case '7':
-        case '8':
-        case '9':
-            return (c - 48);
-        case 'A':
-        case 'B':
-        case 'C':
-        case 'D':
-        case 'E':
-        case 'F':
-            return (c - 54);
-        case 'a':
-        case 'b':
-        case 'c':
-        case 'd':
-        case 'e':
-        case 'f':
-            return (c - 86);
-        default:
+        if(c >= '0' && c <= '9') {
+            return c - '0';
+        }
+        else if(c >= 'A' && c <= 'Z') {
+            return c - 'A' + 10;
+        }
+        else if(c >= 'a' && c <= 'z') {
+            return c - 'a' + 10;
+        }
+        else {
             throw std::out_of_range("invalid input for digit");
         }
     }
@@ -215,6 +167,85 @@ namespace decode {
         }
     }
 
+    //eight ascii characters, the first in the low byte
+    inline uint64_t load_8_chars(const char* p) {
+        uint64_t chunk;
+        std::memcpy(&chunk, p, 8);
+        return chunk;
+    }
+
+    //every byte is '0' to '9': the high nibbles must all be 3 and adding 6 must
+    //not carry any low nibble past 9
+    inline bool is_8_digits(const uint64_t chunk) {
+        return ((chunk & 0xF0F0F0F0F0F0F0F0ULL) |
+                (((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) == 0x3333333333333333ULL;
+    }
+
+    //value of eight valid digits by pairing neighbours, then pairs, then quads
+    inline uint32_t parse_8_digits(uint64_t chunk) {
+        chunk -= 0x3030303030303030ULL;
+        chunk = (chunk * 10) + (chunk >> 8);
+        chunk = (((chunk & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+                 (((chunk >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+        return static_cast<uint32_t>(chunk);
+    }
+
+    inline bool try_parse_8_digits(const char* p, uint32_t& value) {
+        const uint64_t chunk = load_8_chars(p);
+        if(!is_8_digits(chunk)) {
+            return false;
+        }
+
+        value = parse_8_digits(chunk);
+        return true;
+    }
+
+    //sixteen digits as the values of the first and last eight, nothing is
+    //written unless all sixteen are digits
+    inline bool try_parse_16_digits(const char* p, uint32_t& high, uint32_t& low) {
+#if defined(__SSSE3__)
+        const __m128i digits = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), _mm_set1_epi8('0'));
+        const __m128i nine = _mm_set1_epi8(9);
+        if(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(digits, nine), digits)) != 0xFFFF) {
+            return false;
+        }
+
+        const __m128i pairs = _mm_maddubs_epi16(digits, _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1));
+        const __m128i quads = _mm_madd_epi16(pairs, _mm_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1));
+        const __m128i packed = _mm_packs_epi32(quads, quads);
+        const __m128i eights = _mm_madd_epi16(packed, _mm_setr_epi16(10000, 1, 10000, 1, 10000, 1, 10000, 1));
+        high = static_cast<uint32_t>(_mm_cvtsi128_si32(eights));
+        low = static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(eights, 4)));
+        return true;
+#else
+        const uint64_t first = load_8_chars(p);
+        const uint64_t second = load_8_chars(p + 8);
+        if(!is_8_digits(first) || !is_8_digits(second)) {
+            return false;
+        }
+
+        high = parse_8_digits(first);
+        low = parse_8_digits(second);
+        return true;
+#endif
+    }
+
+    //n little endian bytes to 2n hex characters, most significant first
+    void hex_encode(const uint8_t* bytes, const size_t n, char* out, const bool upper);
+
+    //2n hex characters, most significant first, to n little endian bytes,
+    //false when any character is not a hex digit
+    bool hex_decode(const char* chars, const size_t n, uint8_t* out);
+
+    //hex of a non-negative little endian value without leading zeros, "0" for zero
+    std::string hex_str(const uint8_t* bytes, const size_t n, const bool upper);
+
+    //optionally signed hex digits into the low n bytes of out, digits past 2n
+    //are dropped. significant is the digit count once leading zeros are
+    //skipped. false when anything other than a sign and hex digits is present.
+    bool hex_to_bytes(const char* input, const size_t length, uint8_t* out, const size_t n,
+                      bool& negative, size_t& significant);
+
     void sign_extend(uint8_t* data, const int size, const int bit);
     int first_set_bit(const uint8_t d);
 }
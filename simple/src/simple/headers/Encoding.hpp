@@ -0,0 +1,313 @@
+#ifndef ENCODING_HPP_3c227c8bfa31e4c7a3e16c595047d6c4d615570b
+#define ENCODING_HPP_3c227c8bfa31e4c7a3e16c595047d6c4d615570b
+
+#include "Fixnum.hpp"
+#include "Format.hpp"
+#include "Limbs.hpp"
+#include "Span.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+//Text encodings for identifiers. The N bits are read as an unsigned number,
+//so negative values round trip through their two's complement pattern, and
+//the digits are written most significant first without leading zeros.
+//Decoders accept leading zero digits so fixed width padding is allowed.
+namespace fixnum {
+
+    struct _Alphabet {
+        const char* digits;
+        uint32_t radix;
+        int bits;
+        int chunk;
+        uint32_t chunk_power;
+        int8_t values[256];
+    };
+
+    inline _Alphabet _make_alphabet(const char* digits, const uint32_t radix) {
+        _Alphabet a;
+        a.digits = digits;
+        a.radix = radix;
+        a.bits = (radix & (radix - 1)) == 0 ? __builtin_ctz(radix) : 0;
+        a.chunk = 0;
+        a.chunk_power = 1;
+        while(static_cast<uint64_t>(a.chunk_power) * radix <= 0xFFFFFFFFULL) {
+            a.chunk_power *= radix;
+            ++a.chunk;
+        }
+
+        std::memset(a.values, -1, sizeof(a.values));
+        for(uint32_t i = 0; i < radix; ++i) {
+            a.values[static_cast<uint8_t>(digits[i])] = static_cast<int8_t>(i);
+        }
+
+        return a;
+    }
+
+    //bitcoin alphabet, no 0, O, I or l
+    inline const _Alphabet& _base58() {
+        static const _Alphabet a = _make_alphabet("123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz", 58);
+        return a;
+    }
+
+    //crockford alphabet, read case insensitively with I and L as 1 and O as 0
+    inline const _Alphabet& _base32() {
+        static const _Alphabet a = []() {
+            _Alphabet ret = _make_alphabet("0123456789ABCDEFGHJKMNPQRSTVWXYZ", 32);
+            for(int c = 'a'; c <= 'z'; ++c) {
+                ret.values[c] = ret.values[c - 'a' + 'A'];
+            }
+
+            ret.values['I'] = ret.values['i'] = ret.values['L'] = ret.values['l'] = 1;
+            ret.values['O'] = ret.values['o'] = 0;
+            return ret;
+        }();
+
+        return a;
+    }
+
+    //url safe alphabet from rfc 4648
+    inline const _Alphabet& _base64() {
+        static const _Alphabet a = _make_alphabet("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_", 64);
+        return a;
+    }
+
+    template<size_t N>
+    constexpr size_t max_base58_size() {
+        //5857 / 1000 is just below log2(58)
+        return ((N * 1000) + 5856) / 5857;
+    }
+
+    template<size_t N>
+    constexpr size_t max_base32_size() {
+        return (N + 4) / 5;
+    }
+
+    template<size_t N>
+    constexpr size_t max_base64_size() {
+        return (N + 5) / 6;
+    }
+
+    //power of two radixes are cut straight out of the bits, the rest take a
+    //limb's worth of digits per divmod_1
+    template<size_t N>
+    size_t _encode_radix(const Fixnum<N>& f, char* out, const _Alphabet& a) {
+        constexpr int count = limbs::count(Fixnum<N>::bytes) + 1;
+        uint32_t x[count];
+        limbs::load(x, count, f.data(), Fixnum<N>::bytes);
+
+        char digits[N + 1];
+        char* const end = digits + sizeof(digits);
+        char* start = end;
+        if(a.bits != 0) {
+            const int total = limbs::bit_length(x, count);
+            const uint32_t mask = a.radix - 1;
+            for(int at = 0; at < total; at += a.bits) {
+                const uint64_t window = x[at / 32] | (static_cast<uint64_t>(x[(at / 32) + 1]) << 32);
+                *--start = a.digits[(window >> (at % 32)) & mask];
+            }
+        }
+        else {
+            int used = limbs::length(x, count);
+            while(used > 0) {
+                uint32_t rem = limbs::divmod_1(x, x, used, a.chunk_power);
+                used = limbs::length(x, used);
+                for(int j = 0; j < a.chunk && (used > 0 || rem != 0); ++j) {
+                    *--start = a.digits[rem % a.radix];
+                    rem /= a.radix;
+                }
+            }
+        }
+
+        if(start == end) {
+            *--start = a.digits[0];
+        }
+
+        std::memcpy(out, start, end - start);
+        return end - start;
+    }
+
+    template<size_t N>
+    Fixnum<N> _decode_radix(const char* text, const size_t length, const _Alphabet& a) {
+        if(length == 0) {
+            throw std::invalid_argument("nothing to decode");
+        }
+
+        //a spare limb catches anything past N bits
+        constexpr int count = limbs::count(Fixnum<N>::bytes) + 1;
+        uint32_t x[count] = { 0 };
+        size_t i = 0;
+        size_t take = length % a.chunk == 0 ? a.chunk : length % a.chunk;
+        while(i < length) {
+            uint32_t chunk = 0;
+            uint32_t scale = 1;
+            for(size_t j = 0; j < take; ++j, ++i) {
+                const int8_t d = a.values[static_cast<uint8_t>(text[i])];
+                if(d < 0) {
+                    throw std::invalid_argument("character is not in the alphabet");
+                }
+
+                chunk = (chunk * a.radix) + d;
+                scale *= a.radix;
+            }
+
+            if(limbs::mul_1(x, count, scale, chunk) != 0 || limbs::bit_length(x, count) > static_cast<int>(N)) {
+                throw std::overflow_error("encoded value does not fit in N bits");
+            }
+
+            take = a.chunk;
+        }
+
+        return limbs::to_fixnum<Fixnum<N>>(x, count);
+    }
+
+    //encodes every value into out with delimiter between them
+    template<size_t N>
+    void _encode_many(Span<const Fixnum<N>> values, const char delimiter, OutputBuffer& out,
+                      const _Alphabet& a, const size_t max_size) {
+        //a fixed buffer only takes each value at its real length, so it is
+        //never refused for text that would have fit. no alphabet here needs
+        //more than one character per bit
+        if(out.fixed()) {
+            char text[N + 1];
+            for(size_t i = 0; i < values.size(); ++i) {
+                if(i > 0) {
+                    out.append(delimiter);
+                }
+
+                out.append(text, _encode_radix(values[i], text, a));
+            }
+
+            return;
+        }
+
+        for(size_t i = 0; i < values.size(); ++i) {
+            char* p = out.reserve(max_size + 1);
+            size_t n = 0;
+            if(i > 0) {
+                p[n++] = delimiter;
+            }
+
+            n += _encode_radix(values[i], p + n, a);
+            out.commit(n);
+        }
+    }
+
+    //splits text on delimiter into out, returns how many values were read
+    template<size_t N>
+    size_t _decode_many(const char* text, const size_t length, const char delimiter,
+                        Span<Fixnum<N>> out, const _Alphabet& a) {
+        size_t decoded = 0;
+        size_t first = 0;
+        while(first < length) {
+            const char* stop = static_cast<const char*>(std::memchr(text + first, delimiter, length - first));
+            const size_t last = stop == nullptr ? length : stop - text;
+            if(decoded == out.size()) {
+                throw std::overflow_error("more encoded values than room for them");
+            }
+
+            out[decoded++] = _decode_radix<N>(text + first, last - first, a);
+            first = last + 1;
+        }
+
+        return decoded;
+    }
+
+    //out must hold max_base58_size<N>() characters, returns how many were written
+    template<size_t N>
+    size_t to_base58(const Fixnum<N>& f, char* out) {
+        return _encode_radix(f, out, _base58());
+    }
+
+    template<size_t N>
+    std::string to_base58(const Fixnum<N>& f) {
+        char text[max_base58_size<N>()];
+        return std::string(text, to_base58(f, text));
+    }
+
+    template<size_t N>
+    void to_base58(Span<const Fixnum<N>> values, const char delimiter, OutputBuffer& out) {
+        _encode_many(values, delimiter, out, _base58(), max_base58_size<N>());
+    }
+
+    template<size_t N>
+    Fixnum<N> from_base58(const char* text, const size_t length) {
+        return _decode_radix<N>(text, length, _base58());
+    }
+
+    template<size_t N>
+    Fixnum<N> from_base58(const std::string& text) {
+        return from_base58<N>(text.data(), text.size());
+    }
+
+    template<size_t N>
+    size_t from_base58(const char* text, const size_t length, const char delimiter, Span<Fixnum<N>> out) {
+        return _decode_many(text, length, delimiter, out, _base58());
+    }
+
+    template<size_t N>
+    size_t to_base32(const Fixnum<N>& f, char* out) {
+        return _encode_radix(f, out, _base32());
+    }
+
+    template<size_t N>
+    std::string to_base32(const Fixnum<N>& f) {
+        char text[max_base32_size<N>()];
+        return std::string(text, to_base32(f, text));
+    }
+
+    template<size_t N>
+    void to_base32(Span<const Fixnum<N>> values, const char delimiter, OutputBuffer& out) {
+        _encode_many(values, delimiter, out, _base32(), max_base32_size<N>());
+    }
+
+    template<size_t N>
+    Fixnum<N> from_base32(const char* text, const size_t length) {
+        return _decode_radix<N>(text, length, _base32());
+    }
+
+    template<size_t N>
+    Fixnum<N> from_base32(const std::string& text) {
+        return from_base32<N>(text.data(), text.size());
+    }
+
+    template<size_t N>
+    size_t from_base32(const char* text, const size_t length, const char delimiter, Span<Fixnum<N>> out) {
+        return _decode_many(text, length, delimiter, out, _base32());
+    }
+
+    template<size_t N>
+    size_t to_base64(const Fixnum<N>& f, char* out) {
+        return _encode_radix(f, out, _base64());
+    }
+
+    template<size_t N>
+    std::string to_base64(const Fixnum<N>& f) {
+        char text[max_base64_size<N>()];
+        return std::string(text, to_base64(f, text));
+    }
+
+    template<size_t N>
+    void to_base64(Span<const Fixnum<N>> values, const char delimiter, OutputBuffer& out) {
+        _encode_many(values, delimiter, out, _base64(), max_base64_size<N>());
+    }
+
+    template<size_t N>
+    Fixnum<N> from_base64(const char* text, const size_t length) {
+        return _decode_radix<N>(text, length, _base64());
+    }
+
+    template<size_t N>
+    Fixnum<N> from_base64(const std::string& text) {
+        return from_base64<N>(text.data(), text.size());
+    }
+
+    template<size_t N>
+    size_t from_base64(const char* text, const size_t length, const char delimiter, Span<Fixnum<N>> out) {
+        return _decode_many(text, length, delimiter, out, _base64());
+    }
+}
+
+#endif
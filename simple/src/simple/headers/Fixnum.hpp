@@ -2,6 +2,7 @@
 #define FIXNUM_HPP_aaa1b32b84e336737f7e4626a43d20ee6cbee3e3
 
 #include "Decode.hpp"
+#include "Limbs.hpp"
 
 #include <cstdint>
 #include <iostream>
@@ -17,11 +18,46 @@
 #include <array>
 #include <type_traits>
 
-template<size_t N>
+//How the generic Fixnum lays out its value. The value always sits in the
+//first bytes, little endian, and any storage past it is padding that stays
+//zero. PackedStorage is the original layout and the default.
+struct PackedStorage {
+    static constexpr size_t alignment = 1;
+
+    static constexpr size_t size(const size_t bytes) {
+        return bytes;
+    }
+};
+
+//whole 64 bit limbs, aligned like uint64_t
+struct LimbStorage {
+    static constexpr size_t alignment = 8;
+
+    static constexpr size_t size(const size_t bytes) {
+        return ((bytes + 7) / 8) * 8;
+    }
+};
+
+//limbs padded out to a multiple of Align, so with 32 or 64 a value can be
+//read with aligned vector loads and never straddles a cache line
+template<size_t Align>
+struct AlignedStorage {
+    static_assert(Align >= 8 && (Align & (Align - 1)) == 0, "Align must be a power of two of at least 8");
+    static constexpr size_t alignment = Align;
+
+    static constexpr size_t size(const size_t bytes) {
+        return ((bytes + Align - 1) / Align) * Align;
+    }
+};
+
+template<size_t N, typename Storage = PackedStorage>
 class Fixnum {
 public:
+    using storage = Storage;
     static constexpr size_t bits = N;
     static constexpr int bytes = (N / 8) + ((N % 8) > 0 ? 1 : 0);
+    static constexpr size_t storage_bytes = Storage::size(bytes);
+    static constexpr size_t alignment = Storage::alignment;
     static constexpr int hex_bytes = bytes * 2;
     static constexpr int top_index = bytes - 1;
     static constexpr int top_mask = 0xFF >> ((bytes * 8) - N);
@@ -65,9 +101,13 @@ public:
         }
     }
 
-    Fixnum(const char* input, const int base) : Fixnum(decode::ConvertBase<uint8_t>(input, base, 16)) { }
+    Fixnum(const char* input, const int base) : Fixnum() {
+        _from_string(input, strlen(input), base);
+    }
 
-    Fixnum(const std::string& input, const int base) : Fixnum(decode::ConvertBase<uint8_t>(input, base, 16)) { }
+    Fixnum(const std::string& input, const int base) : Fixnum() {
+        _from_string(input.data(), input.size(), base);
+    }
     
     Fixnum(const decode::ConvertBase<uint8_t>& cb) : Fixnum() {
         if(cb.is_zero()) {
@@ -209,8 +249,7 @@ public:
     Fixnum& operator*=(const Fixnum& n) {
         const bool end_with_complement = is_negative() ^ n.is_negative();
         Fixnum multiplier { n };
-        Fixnum multiplicand(0);
-        
+
         if(is_negative()) {
             _complement();
         }
@@ -219,15 +258,15 @@ public:
             multiplier._complement();
         }
 
-        for(int i = 0; i < N; ++i) {
-            if(_is_bit_set(_data, i)) {
-                _add_to(multiplicand._data, multiplier._data);
-            }
-
-            multiplier <<= 1;
-        }
+        //magnitudes keep the work proportional to the significant limbs
+        constexpr int count = limbs::count(bytes);
+        uint32_t a[count], b[count], product[count];
+        limbs::load(a, count, _data, bytes);
+        limbs::load(b, count, multiplier._data, bytes);
+        limbs::mul(product, count, a, count, b, count);
+        limbs::store(_data, bytes, product, count);
+        _truncate();
 
-        std::memcpy(_data, multiplicand._data, sizeof(_data));
         if(end_with_complement) {
             _complement();
         }
@@ -380,10 +419,12 @@ public:
         if(is_negative() && !is_lowest()) {
             return std::string("-") + complement().str(base);
         }
+        else if(base == 16) {
+            std::string ret = decode::hex_str(data(), bytes, true);
+            return !is_lowest() ? ret : std::string("-") + ret;
+        }
         else {
-            uint8_t pos_hex[hex_bytes] = { 0 };
-            _single_hex_values(pos_hex);
-            std::string ret = decode::convert_pos_str<hex_bytes>(pos_hex, base);
+            std::string ret = decode::bytes_str(data(), bytes, base);
             return !is_lowest() ? ret : std::string("-") + ret;
         }
     }
@@ -410,6 +451,15 @@ public:
         _data[index] = b;
     }
 
+    //raw little endian two's complement, writers must leave the bits above N clear
+    const uint8_t* data() const {
+        return _data;
+    }
+
+    uint8_t* data() {
+        return _data;
+    }
+
     bool bit(const int index) const {
         if(index >= N || index < 0) {
             throw std::overflow_error("can't access bits beyond size of fixnum");
@@ -451,7 +501,23 @@ public:
     }
     
 private:
-    uint8_t _data[bytes];
+    //hex is decoded straight into the bytes, other bases and malformed
+    //input take the digit by digit route
+    void _from_string(const char* input, const size_t length, const int base) {
+        bool negative;
+        size_t significant;
+        if(base != 16 || !decode::hex_to_bytes(input, length, _data, bytes, negative, significant)) {
+            *this = Fixnum(decode::ConvertBase<uint8_t>(std::string(input, length), base, 16));
+            return;
+        }
+
+        _truncate();
+        if(significant <= 2 * bytes && !is_negative() && negative) {
+            _complement();
+        }
+    }
+
+    alignas(Storage::alignment) uint8_t _data[Storage::size(bytes)];
 
     bool _is_bit_set(const uint8_t* d, const int bit) const {
         const int index = bit / 8;
@@ -535,13 +601,6 @@ private:
         _complement(_data);
     }
 
-    void _single_hex_values(uint8_t* d) const {
-        for(int i = 0; i < bytes; ++i) {
-            d[2 * i] = _data[i] & 0xF;
-            d[(2 * i) + 1] = (_data[i] >> 4) & 0xF;
-        }
-    }
-
     static void _truncate(uint8_t* d) {
         d[top_index] = d[top_index] & top_mask;
     }
@@ -699,7 +758,14 @@ public:
     static constexpr size_t N = 8;
     static constexpr size_t bits = N;
     static constexpr int bytes = 1;
+    using storage = PackedStorage;
+    static constexpr size_t storage_bytes = bytes;
+    static constexpr size_t alignment = alignof(int8_t);
     static constexpr int hex_bytes = bytes * 2;
+    static constexpr int top_index = bytes - 1;
+    static constexpr int top_mask = 0xFF;
+    static constexpr int sign_mask = 0x80;
+    static constexpr int unsigned_mask = 0x7F;
     
     static Fixnum lowest() {
         return Fixnum(std::numeric_limits<int8_t>::lowest());
@@ -725,9 +791,13 @@ public:
     }
 
 
-    Fixnum(const char* input, const int base) : Fixnum(decode::ConvertBase<uint8_t>(input, base, 16)) { }
+    Fixnum(const char* input, const int base) : Fixnum() {
+        _from_string(input, strlen(input), base);
+    }
 
-    Fixnum(const std::string& input, const int base) : Fixnum(decode::ConvertBase<uint8_t>(input, base, 16)) { }
+    Fixnum(const std::string& input, const int base) : Fixnum() {
+        _from_string(input.data(), input.size(), base);
+    }
 
     Fixnum(const decode::ConvertBase<uint8_t>& cb) : Fixnum() {
         if(cb.is_zero()) {
@@ -907,10 +977,12 @@ public:
         if(is_negative() && !is_lowest()) {
             return std::string("-") + complement().str(base);
         }
+        else if(base == 16) {
+            std::string ret = decode::hex_str(data(), bytes, true);
+            return !is_lowest() ? ret : std::string("-") + ret;
+        }
         else {
-            uint8_t pos_hex[hex_bytes] = { static_cast<uint8_t>(0xF & _data),
-                                           static_cast<uint8_t>(0xF & (_data >> 4)) };
-            std::string ret = decode::convert_pos_str<hex_bytes>(pos_hex, base);
+            std::string ret = decode::bytes_str(data(), bytes, base);
             return !is_lowest() ? ret : std::string("-") + ret;
         }
     }
@@ -931,6 +1003,14 @@ public:
         else throw std::overflow_error("can't access bits beyond size of fixnum");
     }
 
+    const uint8_t* data() const {
+        return reinterpret_cast<const uint8_t*>(&_data);
+    }
+
+    uint8_t* data() {
+        return reinterpret_cast<uint8_t*>(&_data);
+    }
+
     bool bit(const int index) const {
         if(index >= N || index < 0) {
             throw std::overflow_error("can't access bits beyond size of fixnum");
@@ -961,6 +1041,19 @@ public:
     }
     
 private:
+    void _from_string(const char* input, const size_t length, const int base) {
+        bool negative;
+        size_t significant;
+        if(base != 16 || !decode::hex_to_bytes(input, length, data(), bytes, negative, significant)) {
+            *this = Fixnum(decode::ConvertBase<uint8_t>(std::string(input, length), base, 16));
+            return;
+        }
+
+        if(significant <= 2 * bytes && !is_negative() && negative) {
+            _data = -_data;
+        }
+    }
+
     int8_t _data;
 };
 
@@ -970,7 +1063,14 @@ public:
     static constexpr size_t N = 16;
     static constexpr size_t bits = N;
     static constexpr int bytes = 2;
+    using storage = PackedStorage;
+    static constexpr size_t storage_bytes = bytes;
+    static constexpr size_t alignment = alignof(int16_t);
     static constexpr int hex_bytes = bytes * 2;
+    static constexpr int top_index = bytes - 1;
+    static constexpr int top_mask = 0xFF;
+    static constexpr int sign_mask = 0x80;
+    static constexpr int unsigned_mask = 0x7F;
     
     static Fixnum lowest() {
         return Fixnum(std::numeric_limits<int16_t>::lowest());
@@ -997,9 +1097,13 @@ public:
         }
     }
 
-    Fixnum(const char* input, const int base) : Fixnum(decode::ConvertBase<uint8_t>(input, base, 16)) { }
+    Fixnum(const char* input, const int base) : Fixnum() {
+        _from_string(input, strlen(input), base);
+    }
 
-    Fixnum(const std::string& input, const int base) : Fixnum(decode::ConvertBase<uint8_t>(input, base, 16)) { }
+    Fixnum(const std::string& input, const int base) : Fixnum() {
+        _from_string(input.data(), input.size(), base);
+    }
 
     Fixnum(const decode::ConvertBase<uint8_t>& cb) : Fixnum() {
         if(cb.is_zero()) {
@@ -1182,13 +1286,12 @@ public:
         if(is_negative() && !is_lowest()) {
             return std::string("-") + complement().str(base);
         }
+        else if(base == 16) {
+            std::string ret = decode::hex_str(data(), bytes, true);
+            return !is_lowest() ? ret : std::string("-") + ret;
+        }
         else {
-            uint8_t pos_hex[hex_bytes] = { static_cast<uint8_t>(0xF & _data),
-                                           static_cast<uint8_t>(0xF & (_data >> 4)),
-                                           static_cast<uint8_t>(0xF & (_data >> 8)),
-                                           static_cast<uint8_t>(0xF & (_data >> 12)) };
-
-            std::string ret = decode::convert_pos_str<hex_bytes>(pos_hex, base);
+            std::string ret = decode::bytes_str(data(), bytes, base);
             return !is_lowest() ? ret : (std::string("-") + ret);
         }
     }
@@ -1215,6 +1318,14 @@ public:
         }
     }
 
+    const uint8_t* data() const {
+        return reinterpret_cast<const uint8_t*>(&_data);
+    }
+
+    uint8_t* data() {
+        return reinterpret_cast<uint8_t*>(&_data);
+    }
+
     bool bit(const int index) const {
         if(index >= N || index < 0) {
             throw std::overflow_error("can't access bits beyond size of fixnum");
@@ -1245,6 +1356,19 @@ public:
     }
     
 private:
+    void _from_string(const char* input, const size_t length, const int base) {
+        bool negative;
+        size_t significant;
+        if(base != 16 || !decode::hex_to_bytes(input, length, data(), bytes, negative, significant)) {
+            *this = Fixnum(decode::ConvertBase<uint8_t>(std::string(input, length), base, 16));
+            return;
+        }
+
+        if(significant <= 2 * bytes && !is_negative() && negative) {
+            _data = -_data;
+        }
+    }
+
     int16_t _data;
 };
 
@@ -1254,7 +1378,14 @@ public:
     static constexpr size_t N = 32;
     static constexpr size_t bits = N;
     static constexpr int bytes = 4;
+    using storage = PackedStorage;
+    static constexpr size_t storage_bytes = bytes;
+    static constexpr size_t alignment = alignof(int32_t);
     static constexpr int hex_bytes = bytes * 2;
+    static constexpr int top_index = bytes - 1;
+    static constexpr int top_mask = 0xFF;
+    static constexpr int sign_mask = 0x80;
+    static constexpr int unsigned_mask = 0x7F;
     
     static Fixnum lowest() {
         return Fixnum(std::numeric_limits<int32_t>::lowest());
@@ -1281,9 +1412,13 @@ public:
         }
     }
 
-    Fixnum(const char* input, const int base) : Fixnum(decode::ConvertBase<uint8_t>(input, base, 16)) { }
+    Fixnum(const char* input, const int base) : Fixnum() {
+        _from_string(input, strlen(input), base);
+    }
 
-    Fixnum(const std::string& input, const int base) : Fixnum(decode::ConvertBase<uint8_t>(input, base, 16)) { }
+    Fixnum(const std::string& input, const int base) : Fixnum() {
+        _from_string(input.data(), input.size(), base);
+    }
 
     Fixnum(const decode::ConvertBase<uint8_t>& cb) : Fixnum() {
         if(cb.is_zero()) {
@@ -1473,17 +1608,12 @@ public:
         if(is_negative() && !is_lowest()) {
             return std::string("-") + complement().str(base);
         }
+        else if(base == 16) {
+            std::string ret = decode::hex_str(data(), bytes, true);
+            return !is_lowest() ? ret : std::string("-") + ret;
+        }
         else {
-            uint8_t pos_hex[hex_bytes] = { static_cast<uint8_t>(0xF & _data),
-                                           static_cast<uint8_t>(0xF & (_data >> 4)),
-                                           static_cast<uint8_t>(0xF & (_data >> 8)),
-                                           static_cast<uint8_t>(0xF & (_data >> 12)),
-                                           static_cast<uint8_t>(0xF & (_data >> 16)),
-                                           static_cast<uint8_t>(0xF & (_data >> 20)),
-                                           static_cast<uint8_t>(0xF & (_data >> 24)),
-                                           static_cast<uint8_t>(0xF & (_data >> 28)) };
-                                           
-            std::string ret = decode::convert_pos_str<hex_bytes>(pos_hex, base);
+            std::string ret = decode::bytes_str(data(), bytes, base);
             return !is_lowest() ? ret : std::string("-") + ret;
         }
     }
@@ -1514,6 +1644,14 @@ public:
         }
     }
 
+    const uint8_t* data() const {
+        return reinterpret_cast<const uint8_t*>(&_data);
+    }
+
+    uint8_t* data() {
+        return reinterpret_cast<uint8_t*>(&_data);
+    }
+
     bool bit(const int index) const {
         if(index >= N || index < 0) {
             throw std::overflow_error("can't access bits beyond size of fixnum");
@@ -1544,6 +1682,19 @@ public:
     }
     
 private:
+    void _from_string(const char* input, const size_t length, const int base) {
+        bool negative;
+        size_t significant;
+        if(base != 16 || !decode::hex_to_bytes(input, length, data(), bytes, negative, significant)) {
+            *this = Fixnum(decode::ConvertBase<uint8_t>(std::string(input, length), base, 16));
+            return;
+        }
+
+        if(significant <= 2 * bytes && !is_negative() && negative) {
+            _data = -_data;
+        }
+    }
+
     int32_t _data;
 };
 
@@ -1553,7 +1704,14 @@ public:
     static constexpr size_t N = 64;
     static constexpr size_t bits = N;
     static constexpr int bytes = 8;
+    using storage = PackedStorage;
+    static constexpr size_t storage_bytes = bytes;
+    static constexpr size_t alignment = alignof(int64_t);
     static constexpr int hex_bytes = bytes * 2;
+    static constexpr int top_index = bytes - 1;
+    static constexpr int top_mask = 0xFF;
+    static constexpr int sign_mask = 0x80;
+    static constexpr int unsigned_mask = 0x7F;
     
     static Fixnum lowest() {
         return Fixnum(std::numeric_limits<int64_t>::lowest());
@@ -1580,9 +1738,13 @@ public:
         }
     }
 
-    Fixnum(const char* input, const int base) : Fixnum(decode::ConvertBase<uint8_t>(input, base, 16)) { }
+    Fixnum(const char* input, const int base) : Fixnum() {
+        _from_string(input, strlen(input), base);
+    }
 
-    Fixnum(const std::string& input, const int base) : Fixnum(decode::ConvertBase<uint8_t>(input, base, 16)) { }
+    Fixnum(const std::string& input, const int base) : Fixnum() {
+        _from_string(input.data(), input.size(), base);
+    }
 
     Fixnum(const decode::ConvertBase<uint8_t>& cb) : Fixnum() {
         if(cb.is_zero()) {
@@ -1783,25 +1945,12 @@ public:
         if(is_negative() && !is_lowest()) {
             return std::string("-") + complement().str(base);
         }
+        else if(base == 16) {
+            std::string ret = decode::hex_str(data(), bytes, true);
+            return !is_lowest() ? ret : std::string("-") + ret;
+        }
         else {
-            uint8_t pos_hex[hex_bytes] = { static_cast<uint8_t>(0xF & _data),
-                                           static_cast<uint8_t>(0xF & (_data >> 4)),
-                                           static_cast<uint8_t>(0xF & (_data >> 8)),
-                                           static_cast<uint8_t>(0xF & (_data >> 12)),
-                                           static_cast<uint8_t>(0xF & (_data >> 16)),
-                                           static_cast<uint8_t>(0xF & (_data >> 20)),
-                                           static_cast<uint8_t>(0xF & (_data >> 24)),
-                                           static_cast<uint8_t>(0xF & (_data >> 28)),
-                                           static_cast<uint8_t>(0xF & (_data >> 32)),
-                                           static_cast<uint8_t>(0xF & (_data >> 36)),
-                                           static_cast<uint8_t>(0xF & (_data >> 40)),
-                                           static_cast<uint8_t>(0xF & (_data >> 44)),
-                                           static_cast<uint8_t>(0xF & (_data >> 48)),
-                                           static_cast<uint8_t>(0xF & (_data >> 52)),
-                                           static_cast<uint8_t>(0xF & (_data >> 56)),
-                                           static_cast<uint8_t>(0xF & (_data >> 60)) };
-                                           
-            std::string ret = decode::convert_pos_str<hex_bytes>(pos_hex, base);
+            std::string ret = decode::bytes_str(data(), bytes, base);
             return !is_lowest() ? ret : std::string("-") + ret;
         }
     }
@@ -1840,6 +1989,14 @@ public:
         }
     }
 
+    const uint8_t* data() const {
+        return reinterpret_cast<const uint8_t*>(&_data);
+    }
+
+    uint8_t* data() {
+        return reinterpret_cast<uint8_t*>(&_data);
+    }
+
     bool bit(const int index) const {
         if(index >= N || index < 0) {
             throw std::overflow_error("can't access bits beyond size of fixnum");
@@ -1870,14 +2027,27 @@ public:
     }
     
 private:
+    void _from_string(const char* input, const size_t length, const int base) {
+        bool negative;
+        size_t significant;
+        if(base != 16 || !decode::hex_to_bytes(input, length, data(), bytes, negative, significant)) {
+            *this = Fixnum(decode::ConvertBase<uint8_t>(std::string(input, length), base, 16));
+            return;
+        }
+
+        if(significant <= 2 * bytes && !is_negative() && negative) {
+            _data = -_data;
+        }
+    }
+
     int64_t _data;
 };
 
-template<size_t T, size_t S>
-Fixnum<T> fixnum_cast(const Fixnum<S>& source) {
+template<size_t T, size_t S, typename P>
+Fixnum<T> fixnum_cast(const Fixnum<S, P>& source) {
     Fixnum<T> ret { 0 };
     
-    for(int i = 0; i < Fixnum<T>::bytes && i < Fixnum<S>::bytes; ++i) {
+    for(int i = 0; i < Fixnum<T>::bytes && i < Fixnum<S, P>::bytes; ++i) {
         ret.byte(i, source.byte(i));
     }
     
@@ -1888,222 +2058,230 @@ Fixnum<T> fixnum_cast(const Fixnum<S>& source) {
     return ret;
 }
 
+//the same value in another storage layout
+template<typename To, size_t N, typename From>
+Fixnum<N, To> storage_cast(const Fixnum<N, From>& source) {
+    Fixnum<N, To> ret;
+    std::memcpy(ret.data(), source.data(), Fixnum<N, From>::bytes);
+    return ret;
+}
+
 //+ operators
-template<size_t N>
-Fixnum<N> operator+(const Fixnum<N>& one, const Fixnum<N>& two) {
-    Fixnum<N> ret { one };
+template<size_t N, typename S>
+Fixnum<N, S> operator+(const Fixnum<N, S>& one, const Fixnum<N, S>& two) {
+    Fixnum<N, S> ret { one };
     ret += two;
     return ret;
 }
 
-template<size_t N, typename T>
-Fixnum<N> operator+(const Fixnum<N>& one, const T val) {
+template<size_t N, typename S, typename T>
+Fixnum<N, S> operator+(const Fixnum<N, S>& one, const T val) {
     static_assert(std::is_integral<T>::value, "T must be integral type");
     
-    Fixnum<N> ret { one };
+    Fixnum<N, S> ret { one };
     ret += val;
     return ret;
 }
 
-template<size_t N, typename T>
-Fixnum<N> operator+(const T val, const Fixnum<N>& one) {
+template<size_t N, typename S, typename T>
+Fixnum<N, S> operator+(const T val, const Fixnum<N, S>& one) {
     static_assert(std::is_integral<T>::value, "T must be integral type");
     
     return operator+(one, val);
 }
 
-template<size_t N, typename T>
-Fixnum<N>& operator+=(Fixnum<N>& one, const T val) {
+template<size_t N, typename S, typename T>
+Fixnum<N, S>& operator+=(Fixnum<N, S>& one, const T val) {
     static_assert(std::is_integral<T>::value, "T must be integral type");
     
-    return one += Fixnum<N>(val);
+    return one += Fixnum<N, S>(val);
 }
 
 //- operators
-template<size_t N>
-Fixnum<N> operator-(const Fixnum<N>& one, const Fixnum<N>& two) {
-    Fixnum<N> ret { one };
+template<size_t N, typename S>
+Fixnum<N, S> operator-(const Fixnum<N, S>& one, const Fixnum<N, S>& two) {
+    Fixnum<N, S> ret { one };
     ret -= two;
     return ret;
 }
 
-template<size_t N, typename T>
-Fixnum<N>& operator-=(Fixnum<N>& one, const T val) {
+template<size_t N, typename S, typename T>
+Fixnum<N, S>& operator-=(Fixnum<N, S>& one, const T val) {
     static_assert(std::is_integral<T>::value, "T must be integral type");
     
-    return one -= Fixnum<N>(val);
+    return one -= Fixnum<N, S>(val);
 }
 
-template<size_t N, typename T>
-Fixnum<N> operator-(const Fixnum<N>& one, const T val) {
+template<size_t N, typename S, typename T>
+Fixnum<N, S> operator-(const Fixnum<N, S>& one, const T val) {
     static_assert(std::is_integral<T>::value, "T must be integral type");
     
-    Fixnum<N> ret { one };
+    Fixnum<N, S> ret { one };
     ret -= val;
     return ret;
 }
 
-template<size_t N, typename T>
-Fixnum<N> operator-(const T val, const Fixnum<N>& one) {
+template<size_t N, typename S, typename T>
+Fixnum<N, S> operator-(const T val, const Fixnum<N, S>& one) {
     static_assert(std::is_integral<T>::value, "T must be integral type");
     
-    Fixnum<N> ret(val);
+    Fixnum<N, S> ret(val);
     ret -= one;
     return ret;
 }
 
 //* operators
-template<size_t N>
-Fixnum<N> operator*(const Fixnum<N>& one, const Fixnum<N>& two) {
-    Fixnum<N> ret { one };
+template<size_t N, typename S>
+Fixnum<N, S> operator*(const Fixnum<N, S>& one, const Fixnum<N, S>& two) {
+    Fixnum<N, S> ret { one };
     ret *= two;
     return ret;
 }
 
-template<size_t N, typename T>
-Fixnum<N>& operator*=(Fixnum<N>& one, const T val) {
+template<size_t N, typename S, typename T>
+Fixnum<N, S>& operator*=(Fixnum<N, S>& one, const T val) {
     static_assert(std::is_integral<T>::value, "T must be integral type");
     
-    return one *= Fixnum<N>(val);
+    return one *= Fixnum<N, S>(val);
 }
 
-template<size_t N, typename T>
-Fixnum<N> operator*(const Fixnum<N>& one, const T val) {
+template<size_t N, typename S, typename T>
+Fixnum<N, S> operator*(const Fixnum<N, S>& one, const T val) {
     static_assert(std::is_integral<T>::value, "T must be integral type");
     
-    Fixnum<N> ret { one };
+    Fixnum<N, S> ret { one };
     ret *= val;
     return ret;
 }
 
-template<size_t N, typename T>
-Fixnum<N> operator*(const T val, const Fixnum<N>& one) {
+template<size_t N, typename S, typename T>
+Fixnum<N, S> operator*(const T val, const Fixnum<N, S>& one) {
     static_assert(std::is_integral<T>::value, "T must be integral type");
     
     return operator*(one, val);
 }
 
 /// operators
-template<size_t N>
-Fixnum<N> operator/(const Fixnum<N>& one, const Fixnum<N>& two) {
-    Fixnum<N> ret { one };
+template<size_t N, typename S>
+Fixnum<N, S> operator/(const Fixnum<N, S>& one, const Fixnum<N, S>& two) {
+    Fixnum<N, S> ret { one };
     ret /= two;
     return ret;
 }
 
-template<size_t N, typename T>
-Fixnum<N>& operator/=(Fixnum<N>& one, const T val) {
+template<size_t N, typename S, typename T>
+Fixnum<N, S>& operator/=(Fixnum<N, S>& one, const T val) {
     static_assert(std::is_integral<T>::value, "T must be integral type");
     
-    return one /= Fixnum<N>(val);
+    return one /= Fixnum<N, S>(val);
 }
 
-template<size_t N, typename T>
-Fixnum<N> operator/(const Fixnum<N>& one, const T val) {
+template<size_t N, typename S, typename T>
+Fixnum<N, S> operator/(const Fixnum<N, S>& one, const T val) {
     static_assert(std::is_integral<T>::value, "T must be integral type");
     
-    Fixnum<N> ret { one };
+    Fixnum<N, S> ret { one };
     ret /= val;
     return ret;
 }
 
-template<size_t N, typename T>
-Fixnum<N> operator/(const T val, const Fixnum<N>& one) {
+template<size_t N, typename S, typename T>
+Fixnum<N, S> operator/(const T val, const Fixnum<N, S>& one) {
     static_assert(std::is_integral<T>::value, "T must be integral type");
     
-    Fixnum<N> ret(val);
+    Fixnum<N, S> ret(val);
     ret /= one;
     return ret;
 }
 
 //% operators
-template<size_t N>
-Fixnum<N> operator%(const Fixnum<N>& one, const Fixnum<N>& two) {
-    Fixnum<N> ret { one };
+template<size_t N, typename S>
+Fixnum<N, S> operator%(const Fixnum<N, S>& one, const Fixnum<N, S>& two) {
+    Fixnum<N, S> ret { one };
     ret %= two;
     return ret;
 }
 
-template<size_t N, typename T>
-Fixnum<N>& operator%=(Fixnum<N>& one, const T val) {
+template<size_t N, typename S, typename T>
+Fixnum<N, S>& operator%=(Fixnum<N, S>& one, const T val) {
     static_assert(std::is_integral<T>::value, "T must be integral type");
     
-    return one %= Fixnum<N>(val);
+    return one %= Fixnum<N, S>(val);
 }
 
-template<size_t N, typename T>
-Fixnum<N> operator%(const Fixnum<N>& one, const T val) {
+template<size_t N, typename S, typename T>
+Fixnum<N, S> operator%(const Fixnum<N, S>& one, const T val) {
     static_assert(std::is_integral<T>::value, "T must be integral type");
     
-    Fixnum<N> ret { one };
+    Fixnum<N, S> ret { one };
     ret %= val;
     return ret;
 }
 
-template<size_t N, typename T>
-Fixnum<N> operator%(const T val, const Fixnum<N>& one) {
+template<size_t N, typename S, typename T>
+Fixnum<N, S> operator%(const T val, const Fixnum<N, S>& one) {
     static_assert(std::is_integral<T>::value, "T must be integral type");
     
-    Fixnum<N> ret(val);
+    Fixnum<N, S> ret(val);
     ret %= one;
     return ret;
 }
 
 //bitwise operators
-template<size_t N>
-Fixnum<N> operator<<(const Fixnum<N>& one, const int by) {
-    Fixnum<N> ret { one };
+template<size_t N, typename S>
+Fixnum<N, S> operator<<(const Fixnum<N, S>& one, const int by) {
+    Fixnum<N, S> ret { one };
     ret <<= by;
     return ret;
 }
 
-template<size_t N>
-Fixnum<N> operator>>(const Fixnum<N>& one, const int by) {
-    Fixnum<N> ret { one };
+template<size_t N, typename S>
+Fixnum<N, S> operator>>(const Fixnum<N, S>& one, const int by) {
+    Fixnum<N, S> ret { one };
     ret >>= by;
     return ret;
 }
 
-template<size_t N>
-Fixnum<N> operator&(const Fixnum<N>& one, const Fixnum<N>& two) {
-    Fixnum<N> ret { one };
+template<size_t N, typename S>
+Fixnum<N, S> operator&(const Fixnum<N, S>& one, const Fixnum<N, S>& two) {
+    Fixnum<N, S> ret { one };
     ret &= two;
     return ret;
 }
 
-template<size_t N, typename T>
-Fixnum<N>& operator&=(Fixnum<N>& one, const T val) {
+template<size_t N, typename S, typename T>
+Fixnum<N, S>& operator&=(Fixnum<N, S>& one, const T val) {
     static_assert(std::is_integral<T>::value, "T must be integral type");
     
-    return one &= Fixnum<N>(val);
+    return one &= Fixnum<N, S>(val);
 }
 
-template<size_t N>
-Fixnum<N> operator|(const Fixnum<N>& one, const Fixnum<N>& two) {
-    Fixnum<N> ret { one };
+template<size_t N, typename S>
+Fixnum<N, S> operator|(const Fixnum<N, S>& one, const Fixnum<N, S>& two) {
+    Fixnum<N, S> ret { one };
     ret |= two;
     return ret;
 }
 
-template<size_t N, typename T>
-Fixnum<N>& operator|=(Fixnum<N>& one, const T val) {
+template<size_t N, typename S, typename T>
+Fixnum<N, S>& operator|=(Fixnum<N, S>& one, const T val) {
     static_assert(std::is_integral<T>::value, "T must be integral type");
     
-    return one |= Fixnum<N>(val);
+    return one |= Fixnum<N, S>(val);
 }
 
-template<size_t N>
-Fixnum<N> operator^(const Fixnum<N>& one, const Fixnum<N>& two) {
-    Fixnum<N> ret { one };
+template<size_t N, typename S>
+Fixnum<N, S> operator^(const Fixnum<N, S>& one, const Fixnum<N, S>& two) {
+    Fixnum<N, S> ret { one };
     ret ^= two;
     return ret;
 }
 
-template<size_t N, typename T>
-Fixnum<N>& operator^=(Fixnum<N>& one, const T val) {
+template<size_t N, typename S, typename T>
+Fixnum<N, S>& operator^=(Fixnum<N, S>& one, const T val) {
     static_assert(std::is_integral<T>::value, "T must be integral type");
     
-    return one ^= Fixnum<N>(val);
+    return one ^= Fixnum<N, S>(val);
 }
 
 #endif
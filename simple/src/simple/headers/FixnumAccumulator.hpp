@@ -0,0 +1,119 @@
+#ifndef FIXNUMACCUMULATOR_HPP_6653ee25e758c3fcbf5147590ac08065a5dc7172
+#define FIXNUMACCUMULATOR_HPP_6653ee25e758c3fcbf5147590ac08065a5dc7172
+
+#include "Fixnum.hpp"
+#include "Limbs.hpp"
+#include "Span.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+namespace fixnum {
+
+    //Sum of many Fixnum<N> in carry save form. Every 32 bit limb of a value
+    //is added into its own 64 bit lane, so the upper half of each lane soaks
+    //up carries and no add waits on the limb below it. Values are added as
+    //unsigned bit patterns and the negative ones are counted, each taking
+    //2^N back off when the lanes are finally normalized. The result has
+    //ExtraBits of headroom over N and wraps past that like any Fixnum.
+    template<size_t N, size_t ExtraBits = 64>
+    class FixnumAccumulator {
+    public:
+        static_assert(ExtraBits > 0, "the accumulator needs at least one bit of headroom");
+
+        static constexpr size_t result_bits = N + ExtraBits;
+        using Result = Fixnum<result_bits>;
+
+        //a lane can take this many adds before its upper half could overflow
+        static constexpr uint64_t fold_every = 0xFFFFFFFFULL;
+
+        FixnumAccumulator() {
+            reset();
+        }
+
+        void reset() {
+            std::memset(_lanes, 0, sizeof(_lanes));
+            std::memset(_folded, 0, sizeof(_folded));
+            _negatives = 0;
+            _pending = 0;
+            _count = 0;
+        }
+
+        void add(const Fixnum<N>& f) {
+            uint32_t limb[lanes] = { 0 };
+            std::memcpy(limb, f.data(), Fixnum<N>::bytes);
+            for(int i = 0; i < lanes; ++i) {
+                _lanes[i] += limb[i];
+            }
+
+            _negatives += f.is_negative() ? 1 : 0;
+            ++_count;
+            if(++_pending == fold_every) {
+                _fold();
+            }
+        }
+
+        void add(Span<const Fixnum<N>> values) {
+            for(const Fixnum<N>& f : values) {
+                add(f);
+            }
+        }
+
+        FixnumAccumulator& operator+=(const Fixnum<N>& f) {
+            add(f);
+            return *this;
+        }
+
+        //adds the other sum into this one
+        void merge(const FixnumAccumulator& other) {
+            FixnumAccumulator rest(other);
+            rest._fold();
+            _fold();
+            limbs::add(_folded, rest._folded, wide);
+            _count += other._count;
+        }
+
+        uint64_t count() const {
+            return _count;
+        }
+
+        //the only place the lanes are normalized, apart from the fold every
+        //fold_every adds that keeps them from overflowing
+        Result result() const {
+            FixnumAccumulator done(*this);
+            done._fold();
+            return limbs::to_fixnum<Result>(done._folded, wide);
+        }
+
+    private:
+        static constexpr int lanes = limbs::count(Fixnum<N>::bytes);
+        static constexpr int wide = limbs::count(Result::bytes) + 1;
+
+        //carries the lanes into _folded and takes 2^N off for every negative
+        void _fold() {
+            uint64_t carry = 0;
+            for(int i = 0; i < wide; ++i) {
+                const uint64_t lane = i < lanes ? _lanes[i] : 0;
+                const uint64_t t = static_cast<uint64_t>(_folded[i]) + (lane & 0xFFFFFFFF) + carry;
+                _folded[i] = static_cast<uint32_t>(t);
+                carry = (t >> 32) + (lane >> 32);
+            }
+
+            uint32_t owed[wide] = { static_cast<uint32_t>(_negatives), static_cast<uint32_t>(_negatives >> 32) };
+            limbs::shl(owed, wide, static_cast<int>(N));
+            limbs::sub(_folded, owed, wide);
+
+            std::memset(_lanes, 0, sizeof(_lanes));
+            _negatives = 0;
+            _pending = 0;
+        }
+
+        uint64_t _lanes[lanes];
+        uint32_t _folded[wide];
+        uint64_t _negatives;
+        uint64_t _pending;
+        uint64_t _count;
+    };
+}
+
+#endif
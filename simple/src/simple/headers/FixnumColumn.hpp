@@ -0,0 +1,324 @@
+#ifndef FIXNUMCOLUMN_HPP_171c9b03dc8733d2f570ed08a3f77218e3c401af
+#define FIXNUMCOLUMN_HPP_171c9b03dc8733d2f570ed08a3f77218e3c401af
+
+#include "Fixnum.hpp"
+#include "Limbs.hpp"
+#include "Span.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+//Block compressed columns of Fixnum<N>. Each block stores its values as
+//residuals from a reference, either the block minimum (frame of reference) or
+//the minimum step between neighbours (delta), bit packed at the width of the
+//largest residual. All of the arithmetic wraps mod 2^N like Fixnum itself.
+namespace fixnum {
+
+    enum class ColumnMode : uint8_t {
+        automatic,
+        frame_of_reference,
+        delta
+    };
+
+    constexpr size_t column_block = 128;
+
+    template<size_t N>
+    class FixnumColumn {
+    public:
+        static constexpr int words = (Fixnum<N>::bytes + 7) / 8;
+
+        FixnumColumn() : _size(0), _words(1, 0) {}
+
+        explicit FixnumColumn(Span<const Fixnum<N>> values, const ColumnMode mode = ColumnMode::automatic) : FixnumColumn() {
+            for(size_t start = 0; start < values.size(); start += column_block) {
+                const size_t count = std::min(column_block, values.size() - start);
+                _encode_block(values.data() + start, count, mode);
+            }
+
+            _size = values.size();
+        }
+
+        size_t size() const {
+            return _size;
+        }
+
+        size_t block_count() const {
+            return _blocks.size();
+        }
+
+        size_t compressed_bytes() const {
+            return (_words.size() * sizeof(uint64_t)) + (_blocks.size() * sizeof(Block));
+        }
+
+        int block_width(const size_t block) const {
+            return _blocks[block].width;
+        }
+
+        ColumnMode block_mode(const size_t block) const {
+            return _blocks[block].mode;
+        }
+
+        //writes the values of one block to out and returns how many there were
+        size_t decode_block(const size_t block, Fixnum<N>* out) const {
+            const Block& b = _blocks[block];
+            if(b.width <= 64) {
+                _decode_narrow(b, out);
+                return b.count;
+            }
+
+            uint64_t value[words];
+            uint64_t residual[words];
+
+            if(b.mode == ColumnMode::frame_of_reference) {
+                for(uint32_t j = 0; j < b.count; ++j) {
+                    _residual(b, j, residual);
+                    _add(residual, b.reference);
+                    _store(residual, out[j]);
+                }
+            }
+            else {
+                std::memcpy(value, b.first, sizeof(value));
+                _store(value, out[0]);
+                for(uint32_t j = 1; j < b.count; ++j) {
+                    _residual(b, j, residual);
+                    _add(value, b.reference);
+                    _add(value, residual);
+                    _store(value, out[j]);
+                }
+            }
+
+            return b.count;
+        }
+
+        void decode(Span<Fixnum<N>> out) const {
+            if(out.size() < _size) {
+                throw std::overflow_error("not enough room to decode column");
+            }
+
+            Fixnum<N>* p = out.data();
+            for(size_t block = 0; block < _blocks.size(); ++block) {
+                p += decode_block(block, p);
+            }
+        }
+
+        //frame of reference blocks are read directly, delta blocks sum up to the index
+        Fixnum<N> get(const size_t index) const {
+            if(index >= _size) {
+                throw std::overflow_error("column index out of range");
+            }
+
+            const Block& b = _blocks[index / column_block];
+            const uint32_t j = index % column_block;
+            uint64_t value[words];
+            uint64_t residual[words];
+
+            if(b.mode == ColumnMode::frame_of_reference) {
+                _residual(b, j, value);
+                _add(value, b.reference);
+            }
+            else {
+                std::memcpy(value, b.first, sizeof(value));
+                for(uint32_t k = 1; k <= j; ++k) {
+                    _residual(b, k, residual);
+                    _add(value, b.reference);
+                    _add(value, residual);
+                }
+            }
+
+            Fixnum<N> ret;
+            _store(value, ret);
+            return ret;
+        }
+
+    private:
+        struct Block {
+            uint64_t reference[words];
+            uint64_t first[words];
+            uint64_t offset;
+            uint32_t count;
+            uint16_t width;
+            ColumnMode mode;
+        };
+
+        size_t _size;
+        //one spare word past the end lets every read take two words unchecked
+        std::vector<uint64_t> _words;
+        std::vector<Block> _blocks;
+
+        static void _load(const Fixnum<N>& f, uint64_t* w) {
+            std::fill(w, w + words, 0);
+            std::memcpy(w, f.data(), Fixnum<N>::bytes);
+        }
+
+        static void _store(const uint64_t* w, Fixnum<N>& f) {
+            std::memcpy(f.data(), w, Fixnum<N>::bytes);
+            f.data()[Fixnum<N>::top_index] &= Fixnum<N>::top_mask;
+        }
+
+        static void _add(uint64_t* a, const uint64_t* b) {
+            uint64_t carry = 0;
+            for(int i = 0; i < words; ++i) {
+                const uint64_t sum = a[i] + b[i];
+                const uint64_t result = sum + carry;
+                carry = (sum < a[i]) | (result < sum);
+                a[i] = result;
+            }
+        }
+
+        //a += v, carrying through the upper words
+        static void _add_1(uint64_t* a, const uint64_t v) {
+            a[0] += v;
+            uint64_t carry = a[0] < v;
+            for(int i = 1; carry != 0 && i < words; ++i) {
+                a[i] += carry;
+                carry = a[i] == 0;
+            }
+        }
+
+        //residuals that fit a word are pulled off with one shift and mask each
+        void _decode_narrow(const Block& b, Fixnum<N>* out) const {
+            const int width = b.width;
+            const uint64_t mask = width == 64 ? ~0ULL : (1ULL << width) - 1;
+            uint64_t pos = b.offset * 64;
+            uint64_t value[words];
+
+            if(b.mode == ColumnMode::frame_of_reference) {
+                for(uint32_t j = 0; j < b.count; ++j, pos += width) {
+                    std::memcpy(value, b.reference, sizeof(value));
+                    _add_1(value, _get_bits(pos) & mask);
+                    _store(value, out[j]);
+                }
+            }
+            else {
+                std::memcpy(value, b.first, sizeof(value));
+                _store(value, out[0]);
+                pos += width;
+                for(uint32_t j = 1; j < b.count; ++j, pos += width) {
+                    _add(value, b.reference);
+                    _add_1(value, _get_bits(pos) & mask);
+                    _store(value, out[j]);
+                }
+            }
+        }
+
+        static int _bit_length(const uint64_t* w) {
+            for(int i = words - 1; i >= 0; --i) {
+                if(w[i] != 0) {
+                    const uint32_t hi = static_cast<uint32_t>(w[i] >> 32);
+                    const uint32_t lo = static_cast<uint32_t>(w[i]);
+                    return (i * 64) + (hi != 0 ? 64 - limbs::leading_zeros(hi) : 32 - limbs::leading_zeros(lo));
+                }
+            }
+
+            return 0;
+        }
+
+        void _put_bits(uint64_t pos, const uint64_t value, const int count) {
+            const uint64_t word = pos / 64;
+            const int shift = pos % 64;
+            _words[word] |= value << shift;
+            if(shift + count > 64) {
+                _words[word + 1] |= value >> (64 - shift);
+            }
+        }
+
+        //the 64 bits starting at pos
+        uint64_t _get_bits(const uint64_t pos) const {
+            const uint64_t word = pos / 64;
+            const int shift = pos % 64;
+            uint64_t v = _words[word] >> shift;
+            if(shift != 0) {
+                v |= _words[word + 1] << (64 - shift);
+            }
+
+            return v;
+        }
+
+        uint64_t _get_bits(const uint64_t pos, const int count) const {
+            const uint64_t v = _get_bits(pos);
+            return count == 64 ? v : v & ((1ULL << count) - 1);
+        }
+
+        void _residual(const Block& b, const uint32_t j, uint64_t* r) const {
+            const uint64_t pos = (b.offset * 64) + (static_cast<uint64_t>(j) * b.width);
+            int remaining = b.width;
+            for(int i = 0; i < words; ++i) {
+                const int take = std::min(64, std::max(0, remaining));
+                r[i] = take == 0 ? 0 : _get_bits(pos + (i * 64), take);
+                remaining -= 64;
+            }
+        }
+
+        void _encode_block(const Fixnum<N>* values, const size_t count, ColumnMode mode) {
+            Block b;
+            std::memset(&b, 0, sizeof(b));
+            b.count = count;
+            _load(values[0], b.first);
+
+            Fixnum<N> low = values[0];
+            for(size_t j = 1; j < count; ++j) {
+                low = std::min(low, values[j]);
+            }
+
+            Fixnum<N> low_step;
+            std::vector<Fixnum<N>> steps(count);
+            for(size_t j = 1; j < count; ++j) {
+                steps[j] = values[j] - values[j - 1];
+                low_step = j == 1 ? steps[j] : std::min(low_step, steps[j]);
+            }
+
+            std::vector<Fixnum<N>> by_reference(count);
+            std::vector<Fixnum<N>> by_delta(count);
+            uint64_t reference_bits[words] = { 0 };
+            uint64_t delta_bits[words] = { 0 };
+            uint64_t w[words];
+            for(size_t j = 0; j < count; ++j) {
+                by_reference[j] = values[j] - low;
+                _load(by_reference[j], w);
+                for(int i = 0; i < words; ++i) {
+                    reference_bits[i] |= w[i];
+                }
+
+                if(j > 0) {
+                    by_delta[j] = steps[j] - low_step;
+                    _load(by_delta[j], w);
+                    for(int i = 0; i < words; ++i) {
+                        delta_bits[i] |= w[i];
+                    }
+                }
+            }
+
+            const int reference_width = _bit_length(reference_bits);
+            const int delta_width = _bit_length(delta_bits);
+            if(mode == ColumnMode::automatic) {
+                mode = delta_width < reference_width ? ColumnMode::delta : ColumnMode::frame_of_reference;
+            }
+
+            const std::vector<Fixnum<N>>& residuals = mode == ColumnMode::delta ? by_delta : by_reference;
+            b.mode = mode;
+            b.width = mode == ColumnMode::delta ? delta_width : reference_width;
+            _load(mode == ColumnMode::delta ? low_step : low, b.reference);
+
+            //the spare word becomes the first word of this block
+            b.offset = _words.size() - 1;
+            const uint64_t bits = static_cast<uint64_t>(b.width) * count;
+            _words.resize(b.offset + ((bits + 63) / 64) + 1, 0);
+
+            for(size_t j = 0; j < count; ++j) {
+                _load(residuals[j], w);
+                const uint64_t pos = (b.offset * 64) + (j * b.width);
+                int remaining = b.width;
+                for(int i = 0; remaining > 0; ++i, remaining -= 64) {
+                    _put_bits(pos + (i * 64), w[i], std::min(64, remaining));
+                }
+            }
+
+            _blocks.push_back(b);
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,202 @@
+#ifndef FIXNUMFILE_HPP_0c3ae96e6274f1c0146409c9abc51b890b273d3c
+#define FIXNUMFILE_HPP_0c3ae96e6274f1c0146409c9abc51b890b273d3c
+
+#include "Fixnum.hpp"
+#include "FixnumView.hpp"
+#include "Hash.hpp"
+#include "Span.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+//On disk layout for arrays of Fixnum<N>: a 64 byte header followed by the
+//elements, each Fixnum<N>::bytes of little endian two's complement exactly as
+//data() holds them, starting on a 64 byte boundary. The format is little
+//endian only, header fields included. The endianness field is always
+//file_little_endian and only exists so a big endian reader, which sees it
+//byte swapped, rejects the file instead of misreading it.
+namespace fixnum {
+
+    constexpr uint32_t file_version = 1;
+    constexpr uint32_t file_little_endian = 1;
+    constexpr uint64_t file_data_offset = 64;
+
+    struct FileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t bits;
+        uint32_t stride;
+        uint32_t endianness;
+        uint64_t count;
+        uint64_t checksum;
+        uint64_t data_offset;
+        uint8_t reserved[16];
+    };
+
+    static_assert(sizeof(FileHeader) == file_data_offset, "header must fill the space before the data");
+
+    FileHeader make_file_header(const uint32_t bits, const uint32_t stride);
+
+    //throws std::runtime_error when the header does not describe an array of
+    //bits wide values that fits in file_size bytes
+    void check_file_header(const FileHeader& header, const uint32_t bits, const uint32_t stride, const uint64_t file_size);
+
+    //elements are chained through the hash seed so the writer can checksum as it streams
+    inline uint64_t file_checksum(const uint64_t running, const uint8_t* element, const int stride) {
+        return hash_bytes(element, stride, running);
+    }
+
+    //read only mmap of a whole file, unmapped on destruction
+    class MappedFile {
+    public:
+        explicit MappedFile(const std::string& path);
+        MappedFile(MappedFile&& other);
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        ~MappedFile();
+
+        const uint8_t* data() const { return _data; }
+        uint64_t size() const { return _size; }
+
+    private:
+        const uint8_t* _data;
+        uint64_t _size;
+    };
+
+    //values go straight to the file as they are written, the header is
+    //patched with the count and checksum on close. Nothing is staged beyond
+    //stdio's own small buffer, so memory use does not grow with the count.
+    template<size_t N>
+    class FixnumFileWriter {
+    public:
+        explicit FixnumFileWriter(const std::string& path)
+            : _file(std::fopen(path.c_str(), "wb")), _header(make_file_header(N, Fixnum<N>::bytes)) {
+            if(_file == nullptr) {
+                throw std::runtime_error("can't open " + path + " for writing");
+            }
+
+            _put(&_header, sizeof(_header));
+        }
+
+        FixnumFileWriter(const FixnumFileWriter&) = delete;
+        FixnumFileWriter& operator=(const FixnumFileWriter&) = delete;
+
+        ~FixnumFileWriter() {
+            try {
+                close();
+            }
+            catch(...) {}
+        }
+
+        void write(const ConstFixnumView<N> f) {
+            _header.checksum = file_checksum(_header.checksum, f.data(), Fixnum<N>::bytes);
+            _put(f.data(), Fixnum<N>::bytes);
+            ++_header.count;
+        }
+
+        void write(Span<const Fixnum<N>> values) {
+            if(sizeof(Fixnum<N>) != Fixnum<N>::bytes) {
+                for(const Fixnum<N>& f : values) {
+                    write(f);
+                }
+                return;
+            }
+
+            for(const Fixnum<N>& f : values) {
+                _header.checksum = file_checksum(_header.checksum, f.data(), Fixnum<N>::bytes);
+            }
+
+            _put(values.data(), values.size() * Fixnum<N>::bytes);
+            _header.count += values.size();
+        }
+
+        uint64_t count() const {
+            return _header.count;
+        }
+
+        void close() {
+            if(_file == nullptr) {
+                return;
+            }
+
+            std::FILE* file = _file;
+            _file = nullptr;
+            const bool ok = std::fseek(file, 0, SEEK_SET) == 0 &&
+                std::fwrite(&_header, sizeof(_header), 1, file) == 1;
+            if(std::fclose(file) != 0 || !ok) {
+                throw std::runtime_error("can't finish writing fixnum file");
+            }
+        }
+
+    private:
+        std::FILE* _file;
+        FileHeader _header;
+
+        void _put(const void* p, const size_t length) {
+            if(_file == nullptr) {
+                throw std::runtime_error("fixnum file is closed");
+            }
+
+            if(length > 0 && std::fwrite(p, length, 1, _file) != 1) {
+                throw std::runtime_error("can't write fixnum file");
+            }
+        }
+    };
+
+    //elements are read in place from the mapping, nothing is parsed or copied
+    template<size_t N>
+    class MappedFixnumArray {
+    public:
+        explicit MappedFixnumArray(const std::string& path, const bool verify = true) : _file(path) {
+            if(_file.size() < sizeof(FileHeader)) {
+                throw std::runtime_error(path + " is too short to be a fixnum file");
+            }
+
+            const FileHeader& header = *reinterpret_cast<const FileHeader*>(_file.data());
+            check_file_header(header, N, Fixnum<N>::bytes, _file.size());
+            _elements = _file.data() + header.data_offset;
+            _count = header.count;
+
+            if(verify) {
+                uint64_t checksum = 0;
+                for(uint64_t i = 0; i < _count; ++i) {
+                    checksum = file_checksum(checksum, _elements + (i * Fixnum<N>::bytes), Fixnum<N>::bytes);
+                }
+
+                if(checksum != header.checksum) {
+                    throw std::runtime_error(path + " failed its checksum");
+                }
+            }
+        }
+
+        size_t size() const {
+            return _count;
+        }
+
+        bool empty() const {
+            return _count == 0;
+        }
+
+        ConstFixnumView<N> operator[](const size_t index) const {
+            return ConstFixnumView<N>(_elements + (index * Fixnum<N>::bytes));
+        }
+
+        Fixnum<N> value(const size_t index) const {
+            return (*this)[index].value();
+        }
+
+        //the raw elements, Fixnum<N>::bytes apiece
+        const uint8_t* data() const {
+            return _elements;
+        }
+
+    private:
+        MappedFile _file;
+        const uint8_t* _elements;
+        size_t _count;
+    };
+}
+
+#endif
@@ -0,0 +1,221 @@
+#ifndef FIXNUMPARSER_HPP_fd4eea6a85b5e0c29ed4591f6c581c7f5d70a1dd
+#define FIXNUMPARSER_HPP_fd4eea6a85b5e0c29ed4591f6c581c7f5d70a1dd
+
+#include "Decode.hpp"
+#include "Fixnum.hpp"
+#include "Limbs.hpp"
+
+#include <cstdint>
+
+namespace fixnum {
+
+    enum class ParseStatus {
+        more,
+        done,
+        overflow,
+        invalid
+    };
+
+    //digit value of c in bases up to 36, 36 or more when c is not a digit at all
+    inline int _digit_value(const char c) {
+        if(c >= '0' && c <= '9') return c - '0';
+        if(c >= 'a' && c <= 'z') return c - 'a' + 10;
+        if(c >= 'A' && c <= 'Z') return c - 'A' + 10;
+        return 36;
+    }
+
+    //Resumable parser for one signed number at a time. Input can arrive in any
+    //number of pieces, digits are folded into limbs as they come so nothing is
+    //buffered. Leading whitespace is skipped, a sign is optional and the first
+    //character that is not a digit in the base ends the number without being
+    //consumed. Nothing throws, problems are reported through status().
+    template<size_t N>
+    class FixnumParser {
+    public:
+        static constexpr int count = limbs::count(Fixnum<N>::bytes) + 1;
+
+        explicit FixnumParser(const int base = 10) : _base(base < 2 || base > 36 ? 0 : base) {
+            _chunk_limit = 1;
+            while(_base != 0 && _chunk_limit <= UINT32_MAX / _base) {
+                _chunk_limit *= _base;
+            }
+
+            reset();
+        }
+
+        void reset() {
+            for(int i = 0; i < count; ++i) {
+                _magnitude[i] = 0;
+            }
+
+            _state = _base == 0 ? State::failed : State::start;
+            _status = _base == 0 ? ParseStatus::invalid : ParseStatus::more;
+            _negative = false;
+            _overflowed = false;
+            _chunk = 0;
+            _chunk_scale = 1;
+        }
+
+        //returns where parsing stopped, end when the number may continue in the
+        //next piece, otherwise the character that ended it
+        const char* feed(const char* begin, const char* end) {
+            const char* p = begin;
+            while(p != end && _status == ParseStatus::more) {
+                const char c = *p;
+                switch(_state) {
+                case State::start:
+                    if(c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+                        ++p;
+                    }
+                    else if(c == '-' || c == '+') {
+                        _negative = c == '-';
+                        _state = State::sign;
+                        ++p;
+                    }
+                    else {
+                        _state = State::sign;
+                    }
+                    break;
+
+                case State::sign:
+                    if(_digit_value(c) >= _base) {
+                        _fail();
+                    }
+                    else {
+                        _state = State::digits;
+                    }
+                    break;
+
+                case State::digits:
+                    p = _digits(p, end);
+                    if(p != end) {
+                        _complete();
+                    }
+                    break;
+
+                case State::failed:
+                    break;
+                }
+            }
+
+            return p;
+        }
+
+        //marks the end of input, a number still in progress is completed
+        ParseStatus finish() {
+            if(_status == ParseStatus::more) {
+                if(_state == State::digits) {
+                    _complete();
+                }
+                else {
+                    _fail();
+                }
+            }
+
+            return _status;
+        }
+
+        ParseStatus status() const {
+            return _status;
+        }
+
+        //the parsed value, only meaningful once status() is done
+        Fixnum<N> value() const {
+            const Fixnum<N> magnitude = limbs::to_fixnum<Fixnum<N>>(_magnitude, count);
+            return _negative ? -magnitude : magnitude;
+        }
+
+    private:
+        enum class State { start, sign, digits, failed };
+
+        int _base;
+        uint32_t _chunk_limit;
+        State _state;
+        ParseStatus _status;
+        bool _negative;
+        bool _overflowed;
+        //digits not yet folded into the magnitude, and base to the number of them
+        uint32_t _chunk;
+        uint32_t _chunk_scale;
+        uint32_t _magnitude[count];
+
+        const char* _digits(const char* p, const char* end) {
+            if(_base == 10) {
+                p = _decimal_runs(p, end);
+            }
+
+            for(; p != end; ++p) {
+                const int d = _digit_value(*p);
+                if(d >= _base) {
+                    break;
+                }
+
+                _chunk = (_chunk * _base) + d;
+                _chunk_scale *= _base;
+                if(_chunk_scale == _chunk_limit) {
+                    _flush();
+                }
+            }
+
+            return p;
+        }
+
+        //whole runs of 16 and then 8 digits are checked and converted together
+        const char* _decimal_runs(const char* p, const char* end) {
+            constexpr uint32_t scale = 100000000;
+            uint32_t high;
+            uint32_t low;
+            while(end - p >= 16 && decode::try_parse_16_digits(p, high, low)) {
+                _flush();
+                _fold(scale, high);
+                _fold(scale, low);
+                p += 16;
+            }
+
+            if(end - p >= 8 && decode::try_parse_8_digits(p, low)) {
+                _flush();
+                _fold(scale, low);
+                p += 8;
+            }
+
+            return p;
+        }
+
+        //the spare limb means anything that carries out is far past N bits,
+        //the exact limit is checked once the number is complete
+        void _fold(const uint32_t scale, const uint32_t digits) {
+            if(!_overflowed) {
+                _overflowed = limbs::mul_1(_magnitude, count, scale, digits) != 0;
+            }
+        }
+
+        void _flush() {
+            if(_chunk_scale != 1) {
+                _fold(_chunk_scale, _chunk);
+                _chunk = 0;
+                _chunk_scale = 1;
+            }
+        }
+
+        //the magnitude may reach 2^(N-1) only when negative
+        void _complete() {
+            _flush();
+            _state = State::failed;
+            if(!_overflowed) {
+                const int bits = limbs::bit_length(_magnitude, count);
+                const int top = static_cast<int>(N) - 1;
+                const bool exactly_top = bits == top + 1 && limbs::trailing_zeros(_magnitude, count) == top;
+                _overflowed = bits > top && !(_negative && exactly_top);
+            }
+
+            _status = _overflowed ? ParseStatus::overflow : ParseStatus::done;
+        }
+
+        void _fail() {
+            _state = State::failed;
+            _status = ParseStatus::invalid;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,309 @@
+#ifndef FIXNUMVIEW_HPP_5da5ca6085b0065077e078054d4102816ff64bc1
+#define FIXNUMVIEW_HPP_5da5ca6085b0065077e078054d4102816ff64bc1
+
+#include "Fixnum.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace fixnum {
+
+    //a += b over little endian byte strings, eight bytes at a time
+    inline void _add_bytes(uint8_t* a, const uint8_t* b, const int bytes) {
+        uint64_t carry = 0;
+        int i = 0;
+        for(; i + 8 <= bytes; i += 8) {
+            uint64_t x, y;
+            std::memcpy(&x, a + i, 8);
+            std::memcpy(&y, b + i, 8);
+            const uint64_t sum = x + y;
+            const uint64_t result = sum + carry;
+            carry = (sum < x) | (result < sum);
+            std::memcpy(a + i, &result, 8);
+        }
+
+        for(; i < bytes; ++i) {
+            const uint32_t sum = static_cast<uint32_t>(a[i]) + b[i] + static_cast<uint32_t>(carry);
+            a[i] = sum & 0xFF;
+            carry = sum >> 8;
+        }
+    }
+
+    //a -= b over little endian byte strings
+    inline void _sub_bytes(uint8_t* a, const uint8_t* b, const int bytes) {
+        uint64_t borrow = 0;
+        int i = 0;
+        for(; i + 8 <= bytes; i += 8) {
+            uint64_t x, y;
+            std::memcpy(&x, a + i, 8);
+            std::memcpy(&y, b + i, 8);
+            const uint64_t diff = x - y;
+            const uint64_t result = diff - borrow;
+            borrow = (x < y) | (diff < borrow);
+            std::memcpy(a + i, &result, 8);
+        }
+
+        for(; i < bytes; ++i) {
+            const uint32_t diff = static_cast<uint32_t>(a[i]) - b[i] - static_cast<uint32_t>(borrow);
+            a[i] = diff & 0xFF;
+            borrow = (diff >> 8) & 1;
+        }
+    }
+
+    //read only Fixnum<N> over bytes owned by someone else, laid out exactly like
+    //Fixnum<N>::data() and with no alignment requirement
+    template<size_t N>
+    class ConstFixnumView {
+    public:
+        static constexpr int bytes = Fixnum<N>::bytes;
+
+        explicit ConstFixnumView(const uint8_t* ptr) : _ptr(ptr) {}
+
+        ConstFixnumView(const Fixnum<N>& f) : _ptr(f.data()) {}
+
+        const uint8_t* data() const {
+            return _ptr;
+        }
+
+        Fixnum<N> value() const {
+            Fixnum<N> ret;
+            std::memcpy(ret.data(), _ptr, bytes);
+            return ret;
+        }
+
+        std::string str(const int base = 10) const {
+            return value().str(base);
+        }
+
+        bool is_negative() const {
+            return (_ptr[Fixnum<N>::top_index] & Fixnum<N>::sign_mask) != 0;
+        }
+
+        bool is_zero() const {
+            for(int i = 0; i < bytes; ++i) {
+                if(_ptr[i] != 0) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        bool bit(const int index) const {
+            return value().bit(index);
+        }
+
+        bool operator==(const ConstFixnumView& rhs) const {
+            return std::memcmp(_ptr, rhs._ptr, bytes) == 0;
+        }
+
+        bool operator!=(const ConstFixnumView& rhs) const {
+            return !(*this == rhs);
+        }
+
+        bool operator<(const ConstFixnumView& rhs) const {
+            return _cmp(rhs) < 0;
+        }
+
+        bool operator<=(const ConstFixnumView& rhs) const {
+            return _cmp(rhs) <= 0;
+        }
+
+        bool operator>(const ConstFixnumView& rhs) const {
+            return _cmp(rhs) > 0;
+        }
+
+        bool operator>=(const ConstFixnumView& rhs) const {
+            return _cmp(rhs) >= 0;
+        }
+
+    protected:
+        const uint8_t* _ptr;
+
+    private:
+        int _cmp(const ConstFixnumView& rhs) const {
+            const bool negative = is_negative();
+            if(negative != rhs.is_negative()) {
+                return negative ? -1 : 1;
+            }
+
+            for(int i = Fixnum<N>::top_index; i >= 0; --i) {
+                if(_ptr[i] != rhs._ptr[i]) {
+                    return _ptr[i] < rhs._ptr[i] ? -1 : 1;
+                }
+            }
+
+            return 0;
+        }
+    };
+
+    //writable view, arithmetic happens in place in the wrapped buffer
+    template<size_t N>
+    class FixnumView : public ConstFixnumView<N> {
+    public:
+        using ConstFixnumView<N>::bytes;
+
+        explicit FixnumView(uint8_t* ptr) : ConstFixnumView<N>(ptr) {}
+
+        FixnumView(Fixnum<N>& f) : ConstFixnumView<N>(f.data()) {}
+
+        uint8_t* data() const {
+            return _bytes();
+        }
+
+        //copies the value of rhs into the wrapped buffer, plain assignment rebinds
+        FixnumView& assign(const ConstFixnumView<N> rhs) {
+            std::memmove(_bytes(), rhs.data(), bytes);
+            return *this;
+        }
+
+        FixnumView& operator+=(const ConstFixnumView<N> rhs) {
+            _add_bytes(_bytes(), rhs.data(), bytes);
+            _truncate();
+            return *this;
+        }
+
+        FixnumView& operator-=(const ConstFixnumView<N> rhs) {
+            _sub_bytes(_bytes(), rhs.data(), bytes);
+            _truncate();
+            return *this;
+        }
+
+        FixnumView& operator++() {
+            return *this += ConstFixnumView<N>(_one());
+        }
+
+        FixnumView& operator--() {
+            return *this -= ConstFixnumView<N>(_one());
+        }
+
+        FixnumView& negate() {
+            uint8_t* d = _bytes();
+            for(int i = 0; i < bytes; ++i) {
+                d[i] = ~d[i];
+            }
+
+            _truncate();
+            return ++(*this);
+        }
+
+        FixnumView& operator*=(const ConstFixnumView<N> rhs) {
+            Fixnum<N> product = this->value();
+            product *= rhs.value();
+            return _store(product);
+        }
+
+        FixnumView& operator/=(const ConstFixnumView<N> rhs) {
+            Fixnum<N> quotient = this->value();
+            quotient /= rhs.value();
+            return _store(quotient);
+        }
+
+        FixnumView& operator%=(const ConstFixnumView<N> rhs) {
+            Fixnum<N> remainder = this->value();
+            remainder %= rhs.value();
+            return _store(remainder);
+        }
+
+        FixnumView& operator<<=(const int by) {
+            Fixnum<N> shifted = this->value();
+            shifted <<= by;
+            return _store(shifted);
+        }
+
+        FixnumView& operator>>=(const int by) {
+            Fixnum<N> shifted = this->value();
+            shifted >>= by;
+            return _store(shifted);
+        }
+
+        FixnumView& operator&=(const ConstFixnumView<N> rhs) {
+            uint8_t* d = _bytes();
+            for(int i = 0; i < bytes; ++i) {
+                d[i] &= rhs.data()[i];
+            }
+
+            return *this;
+        }
+
+        FixnumView& operator|=(const ConstFixnumView<N> rhs) {
+            uint8_t* d = _bytes();
+            for(int i = 0; i < bytes; ++i) {
+                d[i] |= rhs.data()[i];
+            }
+
+            return *this;
+        }
+
+        FixnumView& operator^=(const ConstFixnumView<N> rhs) {
+            uint8_t* d = _bytes();
+            for(int i = 0; i < bytes; ++i) {
+                d[i] ^= rhs.data()[i];
+            }
+
+            return *this;
+        }
+
+        FixnumView& bit(const int index, const bool val) {
+            Fixnum<N> changed = this->value();
+            changed.bit(index, val);
+            return _store(changed);
+        }
+
+        using ConstFixnumView<N>::bit;
+
+    private:
+        //only ever constructed from a writable pointer
+        uint8_t* _bytes() const {
+            return const_cast<uint8_t*>(this->_ptr);
+        }
+
+        void _truncate() {
+            _bytes()[Fixnum<N>::top_index] &= Fixnum<N>::top_mask;
+        }
+
+        FixnumView& _store(const Fixnum<N>& f) {
+            std::memcpy(_bytes(), f.data(), bytes);
+            return *this;
+        }
+
+        static const Fixnum<N>& _one() {
+            static const Fixnum<N> one(1);
+            return one;
+        }
+    };
+
+    //comparisons with a Fixnum on the left, the right side converts implicitly
+    template<size_t N>
+    bool operator==(const Fixnum<N>& lhs, const ConstFixnumView<N> rhs) {
+        return ConstFixnumView<N>(lhs) == rhs;
+    }
+
+    template<size_t N>
+    bool operator!=(const Fixnum<N>& lhs, const ConstFixnumView<N> rhs) {
+        return ConstFixnumView<N>(lhs) != rhs;
+    }
+
+    template<size_t N>
+    bool operator<(const Fixnum<N>& lhs, const ConstFixnumView<N> rhs) {
+        return ConstFixnumView<N>(lhs) < rhs;
+    }
+
+    template<size_t N>
+    bool operator<=(const Fixnum<N>& lhs, const ConstFixnumView<N> rhs) {
+        return ConstFixnumView<N>(lhs) <= rhs;
+    }
+
+    template<size_t N>
+    bool operator>(const Fixnum<N>& lhs, const ConstFixnumView<N> rhs) {
+        return ConstFixnumView<N>(lhs) > rhs;
+    }
+
+    template<size_t N>
+    bool operator>=(const Fixnum<N>& lhs, const ConstFixnumView<N> rhs) {
+        return ConstFixnumView<N>(lhs) >= rhs;
+    }
+}
+
+#endif
@@ -0,0 +1,120 @@
+#ifndef FLOAT_HPP_371a15c650bba2cee0701be27287beb472aeea5f
+#define FLOAT_HPP_371a15c650bba2cee0701be27287beb472aeea5f
+
+#include "Fixnum.hpp"
+#include "Limbs.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+namespace fixnum {
+
+    enum class FloatConversion { exact, truncate };
+
+    //64 bits of a starting at bit at, limbs past n read as zero
+    inline uint64_t _bits_at(const uint32_t* a, const int n, const int at) {
+        const int w = at / 32;
+        const int b = at % 32;
+        const uint64_t lo = (w < n ? a[w] : 0) | (static_cast<uint64_t>(w + 1 < n ? a[w + 1] : 0) << 32);
+        const uint64_t hi = w + 2 < n ? a[w + 2] : 0;
+        return b == 0 ? lo : (lo >> b) | (hi << (64 - b));
+    }
+
+    //any bit of a below bit at
+    inline bool _any_below(const uint32_t* a, const int at) {
+        for(int w = 0; w < at / 32; ++w) {
+            if(a[w] != 0) {
+                return true;
+            }
+        }
+
+        return (at % 32) != 0 && (a[at / 32] & ((1U << (at % 32)) - 1)) != 0;
+    }
+
+    //the magnitude rounded to nearest even with digits significant bits,
+    //the sticky scan stops at the first set bit below the rounding bit
+    template<typename T, size_t N>
+    T _to_floating(const Fixnum<N>& f) {
+        constexpr int digits = std::numeric_limits<T>::digits < 64 ? std::numeric_limits<T>::digits : 64;
+        constexpr int count = limbs::count(Fixnum<N>::bytes);
+        uint32_t a[count];
+        limbs::load_magnitude(a, count, f);
+
+        const int length = limbs::bit_length(a, count);
+        const int drop = length > digits ? length - digits : 0;
+        uint64_t mantissa = _bits_at(a, count, drop);
+        int exponent = drop;
+        if(drop > 0) {
+            const bool round = ((a[(drop - 1) / 32] >> ((drop - 1) % 32)) & 1) != 0;
+            if(round && ((mantissa & 1) != 0 || _any_below(a, drop - 1))) {
+                ++mantissa;
+                if(mantissa == (digits == 64 ? 0 : 1ULL << (digits % 64))) {
+                    mantissa = 1ULL << (digits - 1);
+                    ++exponent;
+                }
+            }
+        }
+
+        //mantissa is exact in T and ldexp only moves the exponent, so anything
+        //past the top of the range comes out as infinity
+        const T magnitude = std::ldexp(static_cast<T>(mantissa), exponent);
+        return f.is_negative() ? -magnitude : magnitude;
+    }
+
+    //nearest double, ties to even
+    template<size_t N>
+    double to_double(const Fixnum<N>& f) {
+        return _to_floating<double>(f);
+    }
+
+    //nearest long double where it carries up to 64 significant bits, wider
+    //formats are rounded to 64 bits first
+    template<size_t N>
+    long double to_long_double(const Fixnum<N>& f) {
+        return _to_floating<long double>(f);
+    }
+
+    //exact throws invalid_argument for a fractional d, truncate drops the
+    //fraction. either way d must be finite and fit in N bits.
+    template<size_t N>
+    Fixnum<N> from_double(const double d, const FloatConversion mode = FloatConversion::exact) {
+        if(!std::isfinite(d)) {
+            throw std::invalid_argument("can't convert nan or infinity to a fixnum");
+        }
+
+        const double whole = std::trunc(d);
+        if(mode == FloatConversion::exact && whole != d) {
+            throw std::invalid_argument("double has a fractional part");
+        }
+
+        if(whole == 0) {
+            return Fixnum<N>(0);
+        }
+
+        //whole is mantissa * 2^(exponent - 53) with a 53 bit mantissa
+        int exponent;
+        const double fraction = std::frexp(std::fabs(whole), &exponent);
+        const bool negative = whole < 0;
+        if(exponent > static_cast<int>(N) - 1 &&
+           !(negative && exponent == static_cast<int>(N) && fraction == 0.5)) {
+            throw std::overflow_error("double is out of range for the fixnum");
+        }
+
+        const uint64_t mantissa = static_cast<uint64_t>(std::ldexp(fraction, 53));
+        constexpr int count = limbs::count(Fixnum<N>::bytes) + 2;
+        uint32_t a[count] = { static_cast<uint32_t>(mantissa), static_cast<uint32_t>(mantissa >> 32) };
+        if(exponent >= 53) {
+            limbs::shl(a, count, exponent - 53);
+        }
+        else {
+            limbs::shr(a, count, 53 - exponent);
+        }
+
+        const Fixnum<N> ret = limbs::to_fixnum<Fixnum<N>>(a, count);
+        return negative ? ret.complement() : ret;
+    }
+}
+
+#endif
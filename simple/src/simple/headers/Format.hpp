@@ -0,0 +1,258 @@
+#ifndef FORMAT_HPP_2f2d163ddebfdbbde48eeba634fb33716543c69b
+#define FORMAT_HPP_2f2d163ddebfdbbde48eeba634fb33716543c69b
+
+#include "Fixnum.hpp"
+#include "Limbs.hpp"
+#include "Parallel.hpp"
+#include "Span.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace fixnum {
+
+    //chunks smaller than this are formatted on the calling thread
+    constexpr size_t format_parallel_grain = 1 << 14;
+
+    //text is written straight into one growing buffer, or into a caller
+    //provided one that throws once it is full
+    class OutputBuffer {
+    public:
+        OutputBuffer() : _ptr(nullptr), _size(0), _capacity(0), _fixed(false) {}
+
+        OutputBuffer(char* data, const size_t capacity) : _ptr(data), _size(0), _capacity(capacity), _fixed(true) {}
+
+        OutputBuffer(const OutputBuffer&) = delete;
+        OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+        const char* data() const { return _ptr; }
+        size_t size() const { return _size; }
+        size_t capacity() const { return _capacity; }
+        bool empty() const { return _size == 0; }
+        bool fixed() const { return _fixed; }
+        void clear() { _size = 0; }
+
+        std::string str() const {
+            return std::string(_ptr, _size);
+        }
+
+        //room for at least n more characters, returns where they go
+        char* reserve(const size_t n) {
+            if(_capacity - _size < n) {
+                if(_fixed) {
+                    throw std::overflow_error("output buffer is full");
+                }
+
+                _owned.resize(std::max(_size + n, 2 * _capacity));
+                _ptr = _owned.data();
+                _capacity = _owned.size();
+            }
+
+            return _ptr + _size;
+        }
+
+        //marks n characters written at reserve() as used
+        void commit(const size_t n) {
+            _size += n;
+        }
+
+        void append(const char* text, const size_t n) {
+            std::memcpy(reserve(n), text, n);
+            _size += n;
+        }
+
+        void append(const char c) {
+            *reserve(1) = c;
+            ++_size;
+        }
+
+    private:
+        std::vector<char> _owned;
+        char* _ptr;
+        size_t _size;
+        size_t _capacity;
+        bool _fixed;
+    };
+
+    //sign plus the digits of 2^N, 1234 / 4096 is just above log10(2)
+    template<size_t N>
+    constexpr size_t max_decimal_size() {
+        return ((N * 1234) >> 12) + 2;
+    }
+
+    inline const char* _digit_pairs() {
+        return "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+               "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+               "8081828384858687888990919293949596979899";
+    }
+
+    //digits of v ending at end, returns where they start
+    inline char* _format_u64(uint64_t v, char* end) {
+        const char* pairs = _digit_pairs();
+        while(v >= 100) {
+            const uint64_t pair = v % 100;
+            v /= 100;
+            end -= 2;
+            std::memcpy(end, pairs + (2 * pair), 2);
+        }
+
+        if(v >= 10) {
+            end -= 2;
+            std::memcpy(end, pairs + (2 * v), 2);
+        }
+        else {
+            *--end = static_cast<char>('0' + v);
+        }
+
+        return end;
+    }
+
+    //exactly nine digits of v ending at end
+    inline char* _format_9(uint32_t v, char* end) {
+        const char* pairs = _digit_pairs();
+        for(int i = 0; i < 4; ++i) {
+            end -= 2;
+            std::memcpy(end, pairs + (2 * (v % 100)), 2);
+            v /= 100;
+        }
+
+        *--end = static_cast<char>('0' + v);
+        return end;
+    }
+
+    //decimal digits of |f| into out, no sign, returns how many were written
+    template<size_t N>
+    size_t _format_magnitude(const Fixnum<N>& f, char* out) {
+        //one spare limb so the last word can always be read as a pair
+        constexpr int count = limbs::count(Fixnum<N>::bytes) + 1;
+        uint32_t a[count];
+        limbs::load_magnitude(a, count, f);
+
+        char digits[max_decimal_size<N>()];
+        char* const end = digits + sizeof(digits);
+        char* start = end;
+
+        //whole 10^9 chunks from the bottom until the rest fits in a word
+        int used = limbs::length(a, count);
+        while(used > 2) {
+            start = _format_9(limbs::divmod_1(a, a, used, 1000000000), start);
+            used = limbs::length(a, used);
+        }
+
+        const uint64_t rest = (static_cast<uint64_t>(a[1]) << 32) | a[0];
+        if(rest != 0 || start == end) {
+            start = _format_u64(rest, start);
+        }
+
+        std::memcpy(out, start, end - start);
+        return end - start;
+    }
+
+    //str(10) into out without allocating, out must hold max_decimal_size<N>()
+    //characters, returns how many were written
+    template<size_t N>
+    size_t format_decimal(const Fixnum<N>& f, char* out) {
+        size_t written = 0;
+        if(f.is_negative()) {
+            out[written++] = '-';
+        }
+
+        return written + _format_magnitude(f, out + written);
+    }
+
+    //upper bound on the characters format_decimal writes for f, taken from
+    //the bit length the same way ilog10 guesses
+    template<size_t N>
+    size_t _decimal_estimate(const Fixnum<N>& f) {
+        constexpr int count = limbs::count(Fixnum<N>::bytes);
+        uint32_t a[count];
+        limbs::load_magnitude(a, count, f);
+        return ((limbs::bit_length(a, count) * 1234) >> 12) + 2;
+    }
+
+    template<size_t N>
+    void _format_run(Span<const Fixnum<N>> values, const char delimiter, OutputBuffer& out) {
+        if(values.empty()) {
+            return;
+        }
+
+        //the estimate can run past what a fixed buffer has left even when
+        //the text itself fits, so there each value goes in at its real length
+        if(out.fixed()) {
+            char digits[max_decimal_size<N>()];
+            for(size_t i = 0; i < values.size(); ++i) {
+                if(i > 0) {
+                    out.append(delimiter);
+                }
+
+                out.append(digits, format_decimal(values[i], digits));
+            }
+
+            return;
+        }
+
+        size_t estimate = values.size();
+        for(const Fixnum<N>& f : values) {
+            estimate += _decimal_estimate(f);
+        }
+
+        char* p = out.reserve(estimate);
+        char* const begin = p;
+        for(size_t i = 0; i < values.size(); ++i) {
+            if(i > 0) {
+                *p++ = delimiter;
+            }
+
+            p += format_decimal(values[i], p);
+        }
+
+        out.commit(p - begin);
+    }
+
+    //decimal values appended to out with delimiter between them, nothing is
+    //written before the first or after the last
+    template<size_t N>
+    void format_many(Span<const Fixnum<N>> values, const char delimiter, OutputBuffer& out) {
+        _format_run(values, delimiter, out);
+    }
+
+    //each thread formats a contiguous chunk into its own buffer and the
+    //chunks are then copied into out in order
+    template<size_t N>
+    void parallel_format_many(Span<const Fixnum<N>> values, const char delimiter, OutputBuffer& out,
+                              const unsigned threads = default_threads()) {
+        if(threads < 2 || values.size() < 2 * format_parallel_grain) {
+            format_many(values, delimiter, out);
+            return;
+        }
+
+        const unsigned chunks = static_cast<unsigned>(std::min<size_t>(threads, values.size() / format_parallel_grain));
+        std::vector<OutputBuffer> parts(chunks);
+        const size_t per = (values.size() + chunks - 1) / chunks;
+        run_threads(chunks, [&](const unsigned t) {
+            const size_t first = t * per;
+            const size_t last = std::min(values.size(), first + per);
+            _format_run(values.subspan(first, last - first), delimiter, parts[t]);
+        });
+
+        size_t total = chunks - 1;
+        for(const OutputBuffer& part : parts) {
+            total += part.size();
+        }
+
+        out.reserve(total);
+        for(unsigned t = 0; t < chunks; ++t) {
+            if(t > 0) {
+                out.append(delimiter);
+            }
+
+            out.append(parts[t].data(), parts[t].size());
+        }
+    }
+}
+
+#endif
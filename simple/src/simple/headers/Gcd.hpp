@@ -0,0 +1,117 @@
+#ifndef GCD_HPP_ca104ab0bcbf854bf24e32b1bc0a2f8d01e87dff
+#define GCD_HPP_ca104ab0bcbf854bf24e32b1bc0a2f8d01e87dff
+
+#include "Fixnum.hpp"
+#include "Limbs.hpp"
+
+#include <array>
+#include <stdexcept>
+
+namespace fixnum {
+
+    //at and above this many limbs Lehmer's algorithm beats the binary one
+    constexpr int lehmer_limbs = 8;
+
+    template<size_t N>
+    Fixnum<N> gcd(const Fixnum<N>& a, const Fixnum<N>& b) {
+        constexpr int count = limbs::count(Fixnum<N>::bytes);
+        uint32_t x[count], y[count];
+        limbs::load_magnitude(x, count, a);
+        limbs::load_magnitude(y, count, b);
+
+        if(count >= lehmer_limbs) {
+            uint32_t scratch[limbs::lehmer_scratch(count)];
+            limbs::lehmer_gcd(x, y, count, scratch);
+        }
+        else {
+            limbs::binary_gcd(x, y, count);
+        }
+
+        return limbs::to_fixnum<Fixnum<N>>(x, count);
+    }
+
+    template<size_t N>
+    Fixnum<N> lcm(const Fixnum<N>& a, const Fixnum<N>& b) {
+        constexpr int count = limbs::count(Fixnum<N>::bytes);
+        const Fixnum<N> g = gcd(a, b);
+        if(g == Fixnum<N>(0)) {
+            return g;
+        }
+
+        uint32_t x[count], y[count], d[count], q[count], r[count], ret[count];
+        uint32_t scratch[limbs::divmod_scratch(count, count)];
+        limbs::load_magnitude(x, count, a);
+        limbs::load_magnitude(y, count, b);
+        limbs::load_magnitude(d, count, g);
+        limbs::divmod(q, r, x, count, d, count, scratch);
+        limbs::mul(ret, count, q, count, y, count);
+        return limbs::to_fixnum<Fixnum<N>>(ret, count);
+    }
+
+    //{ g, x, y } with a*x + b*y == g and g non negative
+    template<size_t N>
+    std::array<Fixnum<N>,3> xgcd(const Fixnum<N>& a, const Fixnum<N>& b) {
+        constexpr int count = limbs::count(Fixnum<N>::bytes);
+        uint32_t r0[count], r1[count], q[count], r[count];
+        uint32_t scratch[limbs::divmod_scratch(count, count)];
+        limbs::load_magnitude(r0, count, a);
+        limbs::load_magnitude(r1, count, b);
+
+        Fixnum<N> x0(1), x1(0), y0(0), y1(1);
+        while(!limbs::is_zero(r1, count)) {
+            limbs::divmod(q, r, r0, count, r1, count, scratch);
+            const Fixnum<N> quotient = limbs::to_fixnum<Fixnum<N>>(q, count);
+
+            Fixnum<N> next = x0 - (quotient * x1);
+            x0 = x1;
+            x1 = next;
+
+            next = y0 - (quotient * y1);
+            y0 = y1;
+            y1 = next;
+
+            std::copy(r1, r1 + count, r0);
+            std::copy(r, r + count, r1);
+        }
+
+        if(a.is_negative()) {
+            x0 = -x0;
+        }
+
+        if(b.is_negative()) {
+            y0 = -y0;
+        }
+
+        return std::array<Fixnum<N>,3> { limbs::to_fixnum<Fixnum<N>>(r0, count), x0, y0 };
+    }
+
+    //inverse of a in [0, m), throws when m is not positive or gcd(a, m) != 1
+    template<size_t N>
+    Fixnum<N> mod_inverse(const Fixnum<N>& a, const Fixnum<N>& m) {
+        const Fixnum<N> zero(0);
+        if(m.is_negative() || m == zero) {
+            throw std::invalid_argument("modulus must be positive");
+        }
+
+        constexpr int count = limbs::count(Fixnum<N>::bytes);
+        uint32_t x[count], mod[count], q[count], r[count];
+        uint32_t scratch[limbs::divmod_scratch(count, count)];
+        limbs::load_magnitude(x, count, a);
+        limbs::load_magnitude(mod, count, m);
+        limbs::divmod(q, r, x, count, mod, count, scratch);
+
+        Fixnum<N> reduced = limbs::to_fixnum<Fixnum<N>>(r, count);
+        if(a.is_negative() && reduced != zero) {
+            reduced = m - reduced;
+        }
+
+        const std::array<Fixnum<N>,3> ext = xgcd(reduced, m);
+        if(ext[0] != Fixnum<N>(1)) {
+            throw std::invalid_argument("value is not invertible for this modulus");
+        }
+
+        return ext[1].is_negative() ? ext[1] + m : ext[1];
+    }
+}
+
+#endif
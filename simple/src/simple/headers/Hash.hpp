@@ -0,0 +1,392 @@
+#ifndef HASH_HPP_43f7d3e9c2d31509884a9a3a61b56145c4f9b9d6
+#define HASH_HPP_43f7d3e9c2d31509884a9a3a61b56145c4f9b9d6
+
+#include "Fixnum.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace fixnum {
+
+    inline uint64_t _mum(const uint64_t a, const uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+        const unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+        return static_cast<uint64_t>(r) ^ static_cast<uint64_t>(r >> 64);
+#else
+        const uint64_t lo_lo = (a & 0xFFFFFFFFu) * (b & 0xFFFFFFFFu);
+        const uint64_t hi_lo = (a >> 32) * (b & 0xFFFFFFFFu);
+        const uint64_t lo_hi = (a & 0xFFFFFFFFu) * (b >> 32);
+        const uint64_t hi_hi = (a >> 32) * (b >> 32);
+        const uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFFu) + lo_hi;
+        const uint64_t low = (cross << 32) | (lo_lo & 0xFFFFFFFFu);
+        const uint64_t high = hi_hi + (hi_lo >> 32) + (cross >> 32);
+        return low ^ high;
+#endif
+    }
+
+    inline uint64_t _read_64(const uint8_t* p, const size_t available) {
+        uint64_t v = 0;
+        std::memcpy(&v, p, available < 8 ? available : 8);
+        return v;
+    }
+
+    //wyhash style mixing over the raw bytes, 16 at a time
+    inline uint64_t hash_bytes(const uint8_t* p, const size_t length, const uint64_t seed = 0) {
+        const uint64_t s0 = 0xa0761d6478bd642fULL;
+        const uint64_t s1 = 0xe7037ed1a0b428dbULL;
+        const uint64_t s2 = 0x8ebc6af09c88c6e3ULL;
+
+        uint64_t h = seed ^ _mum(seed ^ s0, s1);
+        size_t i = 0;
+        for(; i + 16 <= length; i += 16) {
+            h = _mum(_read_64(p + i, 8) ^ s1, _read_64(p + i + 8, 8) ^ h);
+        }
+
+        if(i < length) {
+            const size_t rest = length - i;
+            const uint64_t a = _read_64(p + i, rest);
+            const uint64_t b = rest > 8 ? _read_64(p + i + 8, rest - 8) : 0;
+            h = _mum(a ^ s1, b ^ h);
+        }
+
+        return _mum(h ^ s2, static_cast<uint64_t>(length) ^ s1);
+    }
+
+    template<size_t N>
+    uint64_t hash(const Fixnum<N>& x, const uint64_t seed = 0) {
+        return hash_bytes(x.data(), Fixnum<N>::bytes, seed);
+    }
+
+    template<size_t N>
+    bool same_bytes(const Fixnum<N>& a, const Fixnum<N>& b) {
+        return std::memcmp(a.data(), b.data(), Fixnum<N>::bytes) == 0;
+    }
+
+    //open addressing with inline keys and one control byte per slot, probed
+    //16 slots at a time: a 7 bit hash tag when full, or empty or deleted
+    template<size_t N, typename V>
+    class FixnumMap {
+    public:
+        static constexpr int group_size = 16;
+
+        FixnumMap() : _ctrl(nullptr), _slots(nullptr), _groups(0), _size(0), _deleted(0) {}
+
+        explicit FixnumMap(const size_t expected) : FixnumMap() {
+            reserve(expected);
+        }
+
+        FixnumMap(const FixnumMap&) = delete;
+        FixnumMap& operator=(const FixnumMap&) = delete;
+
+        FixnumMap(FixnumMap&& other) : FixnumMap() {
+            _swap(other);
+        }
+
+        FixnumMap& operator=(FixnumMap&& other) {
+            if(this != &other) {
+                _release();
+                _swap(other);
+            }
+
+            return *this;
+        }
+
+        ~FixnumMap() {
+            _release();
+        }
+
+        size_t size() const { return _size; }
+        bool empty() const { return _size == 0; }
+        size_t capacity() const { return _groups * group_size; }
+
+        void clear() {
+            _destroy_slots();
+            if(_ctrl != nullptr) {
+                std::memset(_ctrl.get(), _empty, capacity());
+            }
+
+            _size = 0;
+            _deleted = 0;
+        }
+
+        void reserve(const size_t expected) {
+            size_t groups = 1;
+            while(groups * group_size * 7 / 8 < expected) {
+                groups *= 2;
+            }
+
+            if(groups > _groups) {
+                _rehash(groups);
+            }
+        }
+
+        V* find(const Fixnum<N>& key) {
+            const size_t index = _find(key, hash(key));
+            return index == _npos ? nullptr : &_slots[index].value;
+        }
+
+        const V* find(const Fixnum<N>& key) const {
+            const size_t index = _find(key, hash(key));
+            return index == _npos ? nullptr : &_slots[index].value;
+        }
+
+        bool contains(const Fixnum<N>& key) const {
+            return find(key) != nullptr;
+        }
+
+        //returns the stored value and whether it was newly inserted
+        std::pair<V*, bool> insert(const Fixnum<N>& key, const V& value) {
+            const uint64_t h = hash(key);
+            const size_t found = _find(key, h);
+            if(found != _npos) {
+                return std::make_pair(&_slots[found].value, false);
+            }
+
+            if(_needs_growth()) {
+                //key or value may live in this table, so they are copied out
+                //before growing moves the slots
+                Slot held { key, value };
+                _grow();
+                return std::make_pair(&_slots[_place(h, std::move(held.key), std::move(held.value))].value, true);
+            }
+
+            return std::make_pair(&_slots[_place(h, key, value)].value, true);
+        }
+
+        V& operator[](const Fixnum<N>& key) {
+            return *insert(key, V()).first;
+        }
+
+        bool erase(const Fixnum<N>& key) {
+            const size_t index = _find(key, hash(key));
+            if(index == _npos) {
+                return false;
+            }
+
+            _slots[index].~Slot();
+
+            //a group that still has an empty slot never continues a probe, so no tombstone is needed
+            const size_t group = index - (index % group_size);
+            if(_match(group, _empty) != 0) {
+                _ctrl[index] = _empty;
+            }
+            else {
+                _ctrl[index] = _tombstone;
+                ++_deleted;
+            }
+
+            --_size;
+            return true;
+        }
+
+        template<typename F>
+        void for_each(F f) const {
+            for(size_t i = 0; i < capacity(); ++i) {
+                if(_is_full(_ctrl[i])) {
+                    f(_slots[i].key, _slots[i].value);
+                }
+            }
+        }
+
+    private:
+        struct Slot {
+            Fixnum<N> key;
+            V value;
+        };
+
+        static constexpr uint8_t _empty = 0x80;
+        static constexpr uint8_t _tombstone = 0xFE;
+        static constexpr size_t _npos = static_cast<size_t>(-1);
+
+        std::unique_ptr<uint8_t[]> _ctrl;
+        Slot* _slots;
+        size_t _groups;
+        size_t _size;
+        size_t _deleted;
+
+        static bool _is_full(const uint8_t c) {
+            return (c & 0x80) == 0;
+        }
+
+        static uint8_t _tag(const uint64_t h) {
+            return static_cast<uint8_t>(h & 0x7F);
+        }
+
+        //bit i set when control byte i of the group equals c
+        uint32_t _match(const size_t group, const uint8_t c) const {
+#if defined(__SSE2__)
+            const __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&_ctrl[group]));
+            return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(static_cast<char>(c)))));
+#else
+            uint32_t mask = 0;
+            for(int i = 0; i < group_size; ++i) {
+                mask |= (_ctrl[group + i] == c ? 1u : 0u) << i;
+            }
+
+            return mask;
+#endif
+        }
+
+        //bit i set when control byte i of the group is empty or deleted
+        uint32_t _match_free(const size_t group) const {
+#if defined(__SSE2__)
+            const __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&_ctrl[group]));
+            return static_cast<uint32_t>(_mm_movemask_epi8(ctrl));
+#else
+            uint32_t mask = 0;
+            for(int i = 0; i < group_size; ++i) {
+                mask |= (_is_full(_ctrl[group + i]) ? 0u : 1u) << i;
+            }
+
+            return mask;
+#endif
+        }
+
+        static int _lowest_bit(const uint32_t mask) {
+            int bit = 0;
+            while(((mask >> bit) & 1) == 0) {
+                ++bit;
+            }
+
+            return bit;
+        }
+
+        size_t _find(const Fixnum<N>& key, const uint64_t h) const {
+            if(_groups == 0) {
+                return _npos;
+            }
+
+            const uint8_t tag = _tag(h);
+            size_t group = (h >> 7) & (_groups - 1);
+            for(size_t step = 1; step <= _groups; ++step) {
+                const size_t base = group * group_size;
+                uint32_t candidates = _match(base, tag);
+                while(candidates != 0) {
+                    const size_t index = base + _lowest_bit(candidates);
+                    if(same_bytes(_slots[index].key, key)) {
+                        return index;
+                    }
+
+                    candidates &= candidates - 1;
+                }
+
+                if(_match(base, _empty) != 0) {
+                    return _npos;
+                }
+
+                //triangular steps visit every group of a power of two table
+                group = (group + step) & (_groups - 1);
+            }
+
+            return _npos;
+        }
+
+        bool _needs_growth() const {
+            return _groups == 0 || (_size + _deleted + 1) * 8 > capacity() * 7;
+        }
+
+        void _grow() {
+            _rehash(_groups == 0 ? 1 : (_size + 1) * 16 > capacity() * 7 ? _groups * 2 : _groups);
+        }
+
+        //the control byte is only marked once the slot holds a live value,
+        //so a throwing copy of V leaves the table as it was
+        template<typename K, typename T>
+        size_t _place(const uint64_t h, K&& key, T&& value) {
+            const size_t index = _free_slot(h);
+            ::new(static_cast<void*>(&_slots[index])) Slot { std::forward<K>(key), std::forward<T>(value) };
+            _commit(index, h);
+            return index;
+        }
+
+        //the table must not need to grow
+        size_t _free_slot(const uint64_t h) {
+            size_t group = (h >> 7) & (_groups - 1);
+            for(size_t step = 1; ; ++step) {
+                const size_t base = group * group_size;
+                const uint32_t free_slots = _match_free(base);
+                if(free_slots != 0) {
+                    return base + _lowest_bit(free_slots);
+                }
+
+                group = (group + step) & (_groups - 1);
+            }
+        }
+
+        void _commit(const size_t index, const uint64_t h) {
+            if(_ctrl[index] == _tombstone) {
+                --_deleted;
+            }
+
+            _ctrl[index] = _tag(h);
+            ++_size;
+        }
+
+        void _rehash(const size_t groups) {
+            FixnumMap next;
+            next._groups = groups;
+            next._ctrl.reset(new uint8_t[groups * group_size]);
+            std::memset(next._ctrl.get(), _empty, groups * group_size);
+            next._slots = std::allocator<Slot>().allocate(groups * group_size);
+
+            for(size_t i = 0; i < capacity(); ++i) {
+                if(_is_full(_ctrl[i])) {
+                    next._place(hash(_slots[i].key), _slots[i].key, std::move(_slots[i].value));
+                }
+            }
+
+            _release();
+            _swap(next);
+        }
+
+        void _destroy_slots() {
+            for(size_t i = 0; i < capacity(); ++i) {
+                if(_is_full(_ctrl[i])) {
+                    _slots[i].~Slot();
+                }
+            }
+        }
+
+        void _release() {
+            if(_slots != nullptr) {
+                _destroy_slots();
+                std::allocator<Slot>().deallocate(_slots, capacity());
+            }
+
+            _ctrl.reset();
+            _slots = nullptr;
+            _groups = 0;
+            _size = 0;
+            _deleted = 0;
+        }
+
+        void _swap(FixnumMap& other) {
+            std::swap(_ctrl, other._ctrl);
+            std::swap(_slots, other._slots);
+            std::swap(_groups, other._groups);
+            std::swap(_size, other._size);
+            std::swap(_deleted, other._deleted);
+        }
+    };
+}
+
+namespace std {
+
+    template<size_t N>
+    struct hash<Fixnum<N>> {
+        size_t operator()(const Fixnum<N>& x) const {
+            return static_cast<size_t>(fixnum::hash(x));
+        }
+    };
+}
+
+#endif
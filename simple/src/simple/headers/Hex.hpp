@@ -0,0 +1,65 @@
+#ifndef HEX_HPP_17ae79d55885176f6f75a95324e4442821508e7d
+#define HEX_HPP_17ae79d55885176f6f75a95324e4442821508e7d
+
+#include "Decode.hpp"
+#include "Fixnum.hpp"
+#include "Span.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+namespace fixnum {
+
+    //fixed width hex of the two's complement bits, unlike str(16) there is no
+    //sign and no stripping of leading zeros, so every value of a width
+    //encodes to the same number of characters
+    template<size_t N>
+    constexpr size_t hex_size() {
+        return 2 * Fixnum<N>::bytes;
+    }
+
+    template<size_t N>
+    void to_hex(const Fixnum<N>& f, char* out, const bool upper = true) {
+        decode::hex_encode(f.data(), Fixnum<N>::bytes, out, upper);
+    }
+
+    template<size_t N>
+    std::string to_hex(const Fixnum<N>& f, const bool upper = true) {
+        std::string ret(hex_size<N>(), '0');
+        to_hex(f, &ret[0], upper);
+        return ret;
+    }
+
+    //out must hold values.size() * hex_size<N>() characters
+    template<size_t N>
+    void to_hex(Span<const Fixnum<N>> values, char* out, const bool upper = true) {
+        for(size_t i = 0; i < values.size(); ++i) {
+            to_hex(values[i], out + (i * hex_size<N>()), upper);
+        }
+    }
+
+    //exactly hex_size<N>() characters as written by to_hex
+    template<size_t N>
+    Fixnum<N> from_hex(const char* in) {
+        Fixnum<N> ret;
+        if(!decode::hex_decode(in, Fixnum<N>::bytes, ret.data())) {
+            throw std::invalid_argument("not a hex digit");
+        }
+
+        if((ret.data()[Fixnum<N>::top_index] & ~Fixnum<N>::top_mask) != 0) {
+            throw std::overflow_error("hex has bits set above N");
+        }
+
+        return ret;
+    }
+
+    template<size_t N>
+    void from_hex(const char* in, Span<Fixnum<N>> out) {
+        for(size_t i = 0; i < out.size(); ++i) {
+            out[i] = from_hex<N>(in + (i * hex_size<N>()));
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef KEYS_HPP_51c079b83d89e51041115c17f5180500d374cd30
+#define KEYS_HPP_51c079b83d89e51041115c17f5180500d374cd30
+
+#include "Bytes.hpp"
+#include "Fixnum.hpp"
+#include "Span.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+
+namespace fixnum {
+
+    //encoded keys are big endian with the sign bit flipped, so memcmp over two
+    //keys of the same width orders them the same way operator< does
+    template<size_t N>
+    constexpr int sortable_key_size() {
+        return Fixnum<N>::bytes;
+    }
+
+    template<size_t N>
+    void encode_sortable_key(const Fixnum<N>& f, uint8_t* out) {
+        to_bytes_be(f, out);
+        out[0] ^= Fixnum<N>::sign_mask;
+    }
+
+    template<size_t N>
+    Fixnum<N> decode_sortable_key(const uint8_t* in) {
+        if((in[0] & ~Fixnum<N>::top_mask) != 0) {
+            throw std::invalid_argument("sortable key has bits set above N");
+        }
+
+        Fixnum<N> ret = from_bytes_be<N>(in, Fixnum<N>::bytes);
+        ret.data()[Fixnum<N>::top_index] ^= Fixnum<N>::sign_mask;
+        return ret;
+    }
+
+    //out must hold values.size() * sortable_key_size<N>() bytes
+    template<size_t N>
+    void encode_sortable_keys(Span<const Fixnum<N>> values, uint8_t* out) {
+        for(size_t i = 0; i < values.size(); ++i) {
+            encode_sortable_key(values[i], out + (i * Fixnum<N>::bytes));
+        }
+    }
+
+    template<size_t N>
+    void decode_sortable_keys(const uint8_t* in, Span<Fixnum<N>> out) {
+        for(size_t i = 0; i < out.size(); ++i) {
+            out[i] = decode_sortable_key<N>(in + (i * Fixnum<N>::bytes));
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,80 @@
+#ifndef LIMBS_HPP_75945544f213288586819596c89c9ef812531265
+#define LIMBS_HPP_75945544f213288586819596c89c9ef812531265
+
+#include <cstdint>
+#include <cstddef>
+
+//Word sized kernels for the wide arithmetic. Limbs are little endian uint32_t
+//with uint64_t intermediates, loaded from and stored back to the byte layout
+//used by Fixnum.
+namespace limbs {
+
+    constexpr int count(const int bytes) {
+        return (bytes + 3) / 4;
+    }
+
+    void load(uint32_t* dst, const int n, const uint8_t* src, const int bytes);
+    void store(uint8_t* dst, const int bytes, const uint32_t* src, const int n);
+    int length(const uint32_t* a, const int n);
+    int bit_length(const uint32_t* a, const int n);
+
+    int cmp(const uint32_t* a, const uint32_t* b, const int n);
+    bool is_zero(const uint32_t* a, const int n);
+    uint32_t add(uint32_t* a, const uint32_t* b, const int n);
+    uint32_t sub(uint32_t* a, const uint32_t* b, const int n);
+    void shl(uint32_t* a, const int n, const int by);
+    void shr(uint32_t* a, const int n, const int by);
+    int trailing_zeros(const uint32_t* a, const int n);
+    int leading_zeros(const uint32_t word);
+
+    //r = a * b truncated to nr limbs, r must not alias a or b
+    void mul(uint32_t* r, const int nr, const uint32_t* a, const int na, const uint32_t* b, const int nb);
+
+    //r = a * a truncated to nr limbs, each cross product is computed once
+    void sqr(uint32_t* r, const int nr, const uint32_t* a, const int na);
+
+    //a = a * m + carry_in, returns the carry out
+    uint32_t mul_1(uint32_t* a, const int n, const uint32_t m, const uint32_t carry_in);
+
+    //q = a / d, returns a % d, q may alias a
+    uint32_t divmod_1(uint32_t* q, const uint32_t* a, const int n, const uint32_t d);
+
+    //limbs of scratch the kernels below need, sized by the caller so the
+    //hot loops never touch the heap
+    constexpr int divmod_scratch(const int na, const int nb) {
+        return na + nb + 1;
+    }
+
+    constexpr int lehmer_scratch(const int n) {
+        return (3 * n) + divmod_scratch(n, n);
+    }
+
+    //Knuth algorithm D, q has na limbs and r has nb limbs, neither may alias
+    //the inputs and b must not be zero, scratch holds divmod_scratch(na, nb)
+    void divmod(uint32_t* q, uint32_t* r, const uint32_t* a, const int na, const uint32_t* b, const int nb, uint32_t* scratch);
+
+    //gcd of a and b left in a, b is clobbered, lehmer_gcd also clobbers
+    //lehmer_scratch(n) limbs of scratch
+    void binary_gcd(uint32_t* a, uint32_t* b, const int n);
+    void lehmer_gcd(uint32_t* a, uint32_t* b, const int n, uint32_t* scratch);
+
+    template<typename F>
+    void load_magnitude(uint32_t* dst, const int n, const F& f) {
+        if(f.is_negative()) {
+            load(dst, n, f.complement().data(), F::bytes);
+        }
+        else {
+            load(dst, n, f.data(), F::bytes);
+        }
+    }
+
+    template<typename F>
+    F to_fixnum(const uint32_t* src, const int n) {
+        F ret;
+        store(ret.data(), F::bytes, src, n);
+        ret.data()[F::top_index] &= F::top_mask;
+        return ret;
+    }
+}
+
+#endif
@@ -0,0 +1,331 @@
+#ifndef PACKEDFIXNUMARRAY_HPP_6e2437344783403c71a79f5bc103ddf92e8a1cdf
+#define PACKEDFIXNUMARRAY_HPP_6e2437344783403c71a79f5bc103ddf92e8a1cdf
+
+#include "Fixnum.hpp"
+#include "Span.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace fixnum {
+
+    //Fixnum<N> values stored back to back at exactly N bits each in 64 bit words.
+    //Elements straddle word boundaries whenever 64 is not a multiple of N.
+    template<size_t N>
+    class PackedFixnumArray {
+    public:
+        static constexpr int chunks = (N + 63) / 64;
+
+        class Reference {
+        public:
+            Reference(PackedFixnumArray& array, const size_t index) : _array(array), _index(index) {}
+
+            operator Fixnum<N>() const {
+                return _array.get(_index);
+            }
+
+            Fixnum<N> value() const {
+                return _array.get(_index);
+            }
+
+            Reference& operator=(const Fixnum<N>& f) {
+                _array.set(_index, f);
+                return *this;
+            }
+
+            Reference& operator=(const Reference& r) {
+                return *this = r.value();
+            }
+
+            Reference& operator+=(const Fixnum<N>& f) {
+                return *this = value() + f;
+            }
+
+            Reference& operator-=(const Fixnum<N>& f) {
+                return *this = value() - f;
+            }
+
+            bool operator==(const Fixnum<N>& f) const {
+                return value() == f;
+            }
+
+            bool operator!=(const Fixnum<N>& f) const {
+                return value() != f;
+            }
+
+            bool operator<(const Fixnum<N>& f) const {
+                return value() < f;
+            }
+
+        private:
+            PackedFixnumArray& _array;
+            size_t _index;
+        };
+
+        PackedFixnumArray() : _size(0), _words(1, 0) {}
+
+        explicit PackedFixnumArray(const size_t size) : PackedFixnumArray() {
+            resize(size);
+        }
+
+        explicit PackedFixnumArray(Span<const Fixnum<N>> values) : PackedFixnumArray(values.size()) {
+            for(size_t i = 0; i < values.size(); ++i) {
+                set(i, values[i]);
+            }
+        }
+
+        size_t size() const {
+            return _size;
+        }
+
+        bool empty() const {
+            return _size == 0;
+        }
+
+        //storage in use, the spare word included
+        size_t bytes() const {
+            return _words.size() * sizeof(uint64_t);
+        }
+
+        const uint64_t* words() const {
+            return _words.data();
+        }
+
+        //new elements are zero
+        void resize(const size_t size) {
+            if(size < _size) {
+                _size = size;
+                _clear_tail();
+            }
+
+            _words.resize(_word_count(size) + 1, 0);
+            _size = size;
+        }
+
+        void push_back(const Fixnum<N>& f) {
+            resize(_size + 1);
+            set(_size - 1, f);
+        }
+
+        Fixnum<N> get(const size_t index) const {
+            uint64_t value[chunks];
+            _read(index, value);
+            Fixnum<N> ret;
+            std::memcpy(ret.data(), value, Fixnum<N>::bytes);
+            return ret;
+        }
+
+        void set(const size_t index, const Fixnum<N>& f) {
+            uint64_t value[chunks] = { 0 };
+            std::memcpy(value, f.data(), Fixnum<N>::bytes);
+
+            uint64_t pos = static_cast<uint64_t>(index) * N;
+            int remaining = N;
+            for(int c = 0; c < chunks; ++c, pos += 64, remaining -= 64) {
+                _put(pos, value[c], std::min(64, remaining));
+            }
+        }
+
+        Fixnum<N> operator[](const size_t index) const {
+            return get(index);
+        }
+
+        Reference operator[](const size_t index) {
+            return Reference(*this, index);
+        }
+
+        Fixnum<N> at(const size_t index) const {
+            _check_index(index);
+            return get(index);
+        }
+
+        Reference at(const size_t index) {
+            _check_index(index);
+            return Reference(*this, index);
+        }
+
+        //copies out.size() elements starting at first
+        void unpack(const size_t first, Span<Fixnum<N>> out) const {
+            if(first + out.size() > _size) {
+                throw std::overflow_error("unpack past the end of packed array");
+            }
+
+            for(size_t i = 0; i < out.size(); ++i) {
+                out[i] = get(first + i);
+            }
+        }
+
+        //sign extended into plain integers, only for N up to 64
+        void unpack(const size_t first, Span<int64_t> out) const {
+            static_assert(N <= 64, "native unpacking needs N <= 64");
+            if(first + out.size() > _size) {
+                throw std::overflow_error("unpack past the end of packed array");
+            }
+
+            const int spare = 64 - N;
+            uint64_t pos = static_cast<uint64_t>(first) * N;
+            for(size_t i = 0; i < out.size(); ++i, pos += N) {
+                const uint64_t v = _get(pos);
+                out[i] = static_cast<int64_t>(v << spare) >> spare;
+            }
+        }
+
+        //element wise a + b mod 2^N for every element at once. The top bit of
+        //each lane is cleared before a plain multi word add so no carry can
+        //leave a lane, then the lane tops are restored by xor.
+        PackedFixnumArray& operator+=(const PackedFixnumArray& rhs) {
+            _check_same_size(rhs);
+            const std::vector<uint64_t>& tops = _lane_tops();
+            uint64_t carry = 0;
+            for(size_t w = 0; w + 1 < _words.size(); ++w) {
+                const uint64_t h = tops[w % tops.size()];
+                const uint64_t a = _words[w];
+                const uint64_t b = rhs._words[w];
+                const uint64_t sum = (a & ~h) + (b & ~h);
+                const uint64_t result = sum + carry;
+                carry = (sum < (a & ~h)) | (result < sum);
+                _words[w] = result ^ ((a ^ b) & h);
+            }
+
+            _clear_tail();
+            return *this;
+        }
+
+        //a - b, with the lane tops forced on in a and off in b no borrow leaves a lane
+        PackedFixnumArray& operator-=(const PackedFixnumArray& rhs) {
+            _check_same_size(rhs);
+            const std::vector<uint64_t>& tops = _lane_tops();
+            uint64_t borrow = 0;
+            for(size_t w = 0; w + 1 < _words.size(); ++w) {
+                const uint64_t h = tops[w % tops.size()];
+                const uint64_t a = _words[w];
+                const uint64_t b = rhs._words[w];
+                const uint64_t diff = (a | h) - (b & ~h);
+                const uint64_t result = diff - borrow;
+                borrow = ((a | h) < (b & ~h)) | (diff < borrow);
+                _words[w] = result ^ ((a ^ ~b) & h);
+            }
+
+            _clear_tail();
+            return *this;
+        }
+
+        PackedFixnumArray& operator&=(const PackedFixnumArray& rhs) {
+            _check_same_size(rhs);
+            for(size_t w = 0; w < _words.size(); ++w) {
+                _words[w] &= rhs._words[w];
+            }
+
+            return *this;
+        }
+
+        PackedFixnumArray& operator|=(const PackedFixnumArray& rhs) {
+            _check_same_size(rhs);
+            for(size_t w = 0; w < _words.size(); ++w) {
+                _words[w] |= rhs._words[w];
+            }
+
+            return *this;
+        }
+
+        PackedFixnumArray& operator^=(const PackedFixnumArray& rhs) {
+            _check_same_size(rhs);
+            for(size_t w = 0; w < _words.size(); ++w) {
+                _words[w] ^= rhs._words[w];
+            }
+
+            return *this;
+        }
+
+    private:
+        size_t _size;
+        //always one word past the last element so two word reads need no check
+        std::vector<uint64_t> _words;
+
+        static size_t _word_count(const size_t size) {
+            return ((static_cast<uint64_t>(size) * N) + 63) / 64;
+        }
+
+        //the top bit of every lane, the pattern repeats every N / gcd(N, 64) words
+        static const std::vector<uint64_t>& _lane_tops() {
+            static const std::vector<uint64_t> tops = []() {
+                size_t a = N, b = 64;
+                while(b != 0) {
+                    const size_t t = a % b;
+                    a = b;
+                    b = t;
+                }
+
+                std::vector<uint64_t> pattern(N / a, 0);
+                for(uint64_t bit = N - 1; bit < pattern.size() * 64; bit += N) {
+                    pattern[bit / 64] |= 1ULL << (bit % 64);
+                }
+
+                return pattern;
+            }();
+
+            return tops;
+        }
+
+        uint64_t _get(const uint64_t pos) const {
+            const uint64_t word = pos / 64;
+            const int shift = pos % 64;
+            uint64_t v = _words[word] >> shift;
+            if(shift != 0) {
+                v |= _words[word + 1] << (64 - shift);
+            }
+
+            return v;
+        }
+
+        void _put(const uint64_t pos, const uint64_t value, const int count) {
+            const uint64_t word = pos / 64;
+            const int shift = pos % 64;
+            const uint64_t mask = count == 64 ? ~0ULL : (1ULL << count) - 1;
+            _words[word] = (_words[word] & ~(mask << shift)) | ((value & mask) << shift);
+            if(shift + count > 64) {
+                const uint64_t high = mask >> (64 - shift);
+                _words[word + 1] = (_words[word + 1] & ~high) | ((value & mask) >> (64 - shift));
+            }
+        }
+
+        void _read(const size_t index, uint64_t* value) const {
+            uint64_t pos = static_cast<uint64_t>(index) * N;
+            int remaining = N;
+            for(int c = 0; c < chunks; ++c, pos += 64, remaining -= 64) {
+                const uint64_t v = _get(pos);
+                value[c] = remaining >= 64 ? v : v & ((1ULL << remaining) - 1);
+            }
+        }
+
+        //the bulk ops run over whole words, whatever lands past the last element goes
+        void _clear_tail() {
+            const uint64_t used = static_cast<uint64_t>(_size) * N;
+            const size_t word = used / 64;
+            if(used % 64 != 0) {
+                _words[word] &= (1ULL << (used % 64)) - 1;
+                std::fill(_words.begin() + word + 1, _words.end(), 0);
+            }
+            else {
+                std::fill(_words.begin() + word, _words.end(), 0);
+            }
+        }
+
+        void _check_index(const size_t index) const {
+            if(index >= _size) {
+                throw std::overflow_error("packed array index out of range");
+            }
+        }
+
+        void _check_same_size(const PackedFixnumArray& rhs) const {
+            if(rhs._size != _size) {
+                throw std::invalid_argument("packed arrays must be the same size");
+            }
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef PARALLEL_HPP_831f969ebc3bc40a3494f847770c0f6275264a2c
+#define PARALLEL_HPP_831f969ebc3bc40a3494f847770c0f6275264a2c
+
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace fixnum {
+
+    inline unsigned default_threads() {
+        const unsigned hc = std::thread::hardware_concurrency();
+        return hc == 0 ? 1 : hc;
+    }
+
+    //calls work(0) .. work(threads - 1), the last on the calling thread
+    template<typename F>
+    void run_threads(const unsigned threads, F work) {
+        std::vector<std::future<void>> pending;
+        for(unsigned t = 0; t + 1 < threads; ++t) {
+            pending.push_back(std::async(std::launch::async, work, t));
+        }
+
+        work(threads - 1);
+        for(auto& p : pending) {
+            p.get();
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,250 @@
+#ifndef POW_HPP_6a87d86ada303c88f2bad7a9afe6c62f89922fd0
+#define POW_HPP_6a87d86ada303c88f2bad7a9afe6c62f89922fd0
+
+#include "Fixnum.hpp"
+#include "Limbs.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace fixnum {
+
+    template<size_t N>
+    Fixnum<N> square(const Fixnum<N>& x) {
+        constexpr int count = limbs::count(Fixnum<N>::bytes);
+        uint32_t a[count], r[count];
+        limbs::load_magnitude(a, count, x);
+        limbs::sqr(r, count, a, count);
+        return limbs::to_fixnum<Fixnum<N>>(r, count);
+    }
+
+    //products kept modulo 2^(32 * Count), which is what truncating pow needs
+    template<int Count>
+    struct _TruncatedProducts {
+        void mul(uint32_t* r, const uint32_t* a, const uint32_t* b) const {
+            limbs::mul(r, Count, a, Count, b, Count);
+        }
+
+        void sqr(uint32_t* r, const uint32_t* a) const {
+            limbs::sqr(r, Count, a, Count);
+        }
+    };
+
+    template<int Count>
+    struct _ModularProducts {
+        uint32_t mod[Count];
+
+        void mul(uint32_t* r, const uint32_t* a, const uint32_t* b) const {
+            uint32_t wide[2 * Count], q[2 * Count], scratch[limbs::divmod_scratch(2 * Count, Count)];
+            limbs::mul(wide, 2 * Count, a, Count, b, Count);
+            limbs::divmod(q, r, wide, 2 * Count, mod, Count, scratch);
+        }
+
+        void sqr(uint32_t* r, const uint32_t* a) const {
+            uint32_t wide[2 * Count], q[2 * Count], scratch[limbs::divmod_scratch(2 * Count, Count)];
+            limbs::sqr(wide, 2 * Count, a, Count);
+            limbs::divmod(q, r, wide, 2 * Count, mod, Count, scratch);
+        }
+    };
+
+    inline int pow_window_bits(const int exponent_bits) {
+        if(exponent_bits > 671) return 6;
+        if(exponent_bits > 239) return 5;
+        if(exponent_bits > 79) return 4;
+        if(exponent_bits > 23) return 3;
+        if(exponent_bits > 8) return 2;
+        return 1;
+    }
+
+    //base^1, base^3, ..., base^(2^window - 1), one row of Count limbs each
+    template<int Count, typename Products>
+    void _odd_powers(std::vector<uint32_t>& table, const uint32_t* base, const int window, const Products& products) {
+        const int rows = 1 << (window - 1);
+        table.assign(static_cast<size_t>(rows) * Count, 0);
+        std::copy(base, base + Count, table.begin());
+
+        uint32_t base_sq[Count];
+        products.sqr(base_sq, base);
+        for(int i = 1; i < rows; ++i) {
+            products.mul(&table[i * Count], &table[(i - 1) * Count], base_sq);
+        }
+    }
+
+    //left to right sliding window over the low exponent_bits bits of exponent
+    template<int Count, typename Products>
+    void _window_pow(uint32_t* result, const std::vector<uint32_t>& table, const int window,
+                     const uint32_t* exponent, const int exponent_bits, const Products& products) {
+        uint32_t tmp[Count];
+        bool started = false;
+        std::fill(result, result + Count, 0);
+        result[0] = 1;
+
+        int i = exponent_bits - 1;
+        while(i >= 0) {
+            if(((exponent[i / 32] >> (i % 32)) & 1) == 0) {
+                if(started) {
+                    products.sqr(tmp, result);
+                    std::copy(tmp, tmp + Count, result);
+                }
+
+                --i;
+                continue;
+            }
+
+            int low = std::max(i - window + 1, 0);
+            while(((exponent[low / 32] >> (low % 32)) & 1) == 0) {
+                ++low;
+            }
+
+            int value = 0;
+            for(int b = i; b >= low; --b) {
+                value = (value << 1) | ((exponent[b / 32] >> (b % 32)) & 1);
+            }
+
+            const uint32_t* odd = &table[(value >> 1) * Count];
+            if(started) {
+                for(int b = i; b >= low; --b) {
+                    products.sqr(tmp, result);
+                    std::copy(tmp, tmp + Count, result);
+                }
+
+                products.mul(tmp, result, odd);
+                std::copy(tmp, tmp + Count, result);
+            }
+            else {
+                std::copy(odd, odd + Count, result);
+                started = true;
+            }
+
+            i = low - 1;
+        }
+    }
+
+    //base^exp truncated to N bits
+    template<size_t N>
+    Fixnum<N> pow(const Fixnum<N>& base, const uint64_t exp) {
+        constexpr int count = limbs::count(Fixnum<N>::bytes);
+        uint32_t b[count], r[count];
+        limbs::load_magnitude(b, count, base);
+
+        const uint32_t e[2] = { static_cast<uint32_t>(exp), static_cast<uint32_t>(exp >> 32) };
+        int bits = 64;
+        while(bits > 0 && ((exp >> (bits - 1)) & 1) == 0) {
+            --bits;
+        }
+
+        const int window = pow_window_bits(bits);
+        const _TruncatedProducts<count> products {};
+        std::vector<uint32_t> table;
+        _odd_powers<count>(table, b, window, products);
+        _window_pow<count>(r, table, window, e, bits, products);
+
+        const Fixnum<N> ret = limbs::to_fixnum<Fixnum<N>>(r, count);
+        return (base.is_negative() && (exp & 1) != 0) ? -ret : ret;
+    }
+
+    //odd powers of a fixed base modulo m, reusable across many exponents
+    template<size_t N>
+    class PowModTable {
+    public:
+        static constexpr int count = limbs::count(Fixnum<N>::bytes);
+
+        PowModTable(const Fixnum<N>& base, const Fixnum<N>& mod, const int window = 5) : _window(window) {
+            if(mod.is_negative() || mod == Fixnum<N>(0)) {
+                throw std::invalid_argument("modulus must be positive");
+            }
+
+            if(window < 1 || window > 8) {
+                throw std::invalid_argument("window must be between 1 and 8 bits");
+            }
+
+            uint32_t b[count], q[count], r[count], scratch[limbs::divmod_scratch(count, count)];
+            limbs::load(_products.mod, count, mod.data(), Fixnum<N>::bytes);
+            limbs::load_magnitude(b, count, base);
+            limbs::divmod(q, r, b, count, _products.mod, count, scratch);
+
+            if(base.is_negative() && !limbs::is_zero(r, count)) {
+                std::copy(_products.mod, _products.mod + count, b);
+                limbs::sub(b, r, count);
+                std::copy(b, b + count, r);
+            }
+
+            _odd_powers<count>(_table, r, _window, _products);
+        }
+
+        Fixnum<N> pow(const Fixnum<N>& exp) const {
+            if(exp.is_negative()) {
+                throw std::invalid_argument("exponent must not be negative");
+            }
+
+            uint32_t e[count], r[count], q[count], one[count] = { 1 };
+            uint32_t scratch[limbs::divmod_scratch(count, count)];
+            limbs::load(e, count, exp.data(), Fixnum<N>::bytes);
+            _window_pow<count>(r, _table, _window, e, limbs::bit_length(e, count), _products);
+
+            //only reachable with a zero exponent, when 1 may still need reducing
+            if(limbs::cmp(r, _products.mod, count) >= 0) {
+                limbs::divmod(q, r, one, count, _products.mod, count, scratch);
+            }
+
+            return limbs::to_fixnum<Fixnum<N>>(r, count);
+        }
+
+    private:
+        _ModularProducts<count> _products;
+        std::vector<uint32_t> _table;
+        int _window;
+    };
+
+    template<size_t N>
+    Fixnum<N> pow_mod(const Fixnum<N>& base, const Fixnum<N>& exp, const Fixnum<N>& mod) {
+        constexpr int count = limbs::count(Fixnum<N>::bytes);
+        uint32_t e[count];
+        limbs::load(e, count, exp.data(), Fixnum<N>::bytes);
+        return PowModTable<N>(base, mod, pow_window_bits(limbs::bit_length(e, count))).pow(exp);
+    }
+
+    //binary addition chain for an exponent known at compile time, unrolled by the templates
+    template<uint64_t E, bool Odd = (E & 1) != 0>
+    struct _AdditionChain;
+
+    template<>
+    struct _AdditionChain<0, false> {
+        template<size_t N>
+        static Fixnum<N> apply(const Fixnum<N>&) {
+            return Fixnum<N>(1);
+        }
+    };
+
+    template<>
+    struct _AdditionChain<1, true> {
+        template<size_t N>
+        static Fixnum<N> apply(const Fixnum<N>& x) {
+            return x;
+        }
+    };
+
+    template<uint64_t E>
+    struct _AdditionChain<E, false> {
+        template<size_t N>
+        static Fixnum<N> apply(const Fixnum<N>& x) {
+            return square(_AdditionChain<E / 2>::apply(x));
+        }
+    };
+
+    template<uint64_t E>
+    struct _AdditionChain<E, true> {
+        template<size_t N>
+        static Fixnum<N> apply(const Fixnum<N>& x) {
+            return _AdditionChain<(E - 1)>::apply(x) * x;
+        }
+    };
+
+    template<uint64_t E, size_t N>
+    Fixnum<N> pow(const Fixnum<N>& base) {
+        return _AdditionChain<E>::apply(base);
+    }
+}
+
+#endif
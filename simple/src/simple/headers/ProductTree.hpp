@@ -0,0 +1,124 @@
+#ifndef PRODUCTTREE_HPP_8e3eef29fbe10b1e701e2fefbee00ea584a11d90
+#define PRODUCTTREE_HPP_8e3eef29fbe10b1e701e2fefbee00ea584a11d90
+
+#include "Fixnum.hpp"
+#include "Parallel.hpp"
+#include "Span.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <future>
+#include <limits>
+#include <vector>
+
+namespace fixnum {
+
+    //subtrees smaller than this are not worth handing to another thread
+    constexpr size_t product_parallel_grain = 64;
+
+    template<size_t N>
+    Fixnum<N> _tree_product(const Fixnum<N>* values, const size_t count, const unsigned threads) {
+        switch(count) {
+        case 0: return Fixnum<N>(1);
+        case 1: return values[0];
+        case 2: return values[0] * values[1];
+        }
+
+        const size_t half = count / 2;
+        if(threads > 1 && count >= product_parallel_grain) {
+            const unsigned left_threads = threads / 2;
+            auto left = std::async(std::launch::async, [=]() { return _tree_product(values, half, left_threads); });
+            const Fixnum<N> right = _tree_product(values + half, count - half, threads - left_threads);
+            return left.get() * right;
+        }
+
+        return _tree_product(values, half, 1) * _tree_product(values + half, count - half, 1);
+    }
+
+    //folds small factors into 63 bit runs so the tree only sees full leaves
+    template<size_t N>
+    void _push_factor(std::vector<Fixnum<N>>& leaves, uint64_t& run, const uint64_t factor) {
+        if(run > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) / factor) {
+            leaves.push_back(Fixnum<N>(static_cast<int64_t>(run)));
+            run = factor;
+        }
+        else {
+            run *= factor;
+        }
+    }
+
+    template<size_t N>
+    Fixnum<N> _leaf_product(std::vector<Fixnum<N>>& leaves, const uint64_t run, const unsigned threads) {
+        if(run > 1 || leaves.empty()) {
+            leaves.push_back(Fixnum<N>(static_cast<int64_t>(run)));
+        }
+
+        return _tree_product(leaves.data(), leaves.size(), threads);
+    }
+
+    template<size_t N>
+    Fixnum<N> product(const Fixnum<N>* values, const size_t count, const unsigned threads = default_threads()) {
+        return _tree_product(values, count, threads);
+    }
+
+    template<size_t N>
+    Fixnum<N> product(Span<const Fixnum<N>> values, const unsigned threads = default_threads()) {
+        return _tree_product(values.data(), values.size(), threads);
+    }
+
+    //n! truncated to N bits like every other Fixnum product
+    template<size_t N>
+    Fixnum<N> factorial(const uint32_t n, const unsigned threads = default_threads()) {
+        std::vector<Fixnum<N>> leaves;
+        uint64_t run = 1;
+        for(uint64_t i = 2; i <= n; ++i) {
+            _push_factor(leaves, run, i);
+        }
+
+        return _leaf_product(leaves, run, threads);
+    }
+
+    //built from the prime factorization (Legendre) so no division is needed
+    //and the result is exact whenever it fits in N bits
+    template<size_t N>
+    Fixnum<N> binomial(const uint32_t n, uint32_t k, const unsigned threads = default_threads()) {
+        if(k > n) {
+            return Fixnum<N>(0);
+        }
+
+        k = std::min(k, n - k);
+        if(k == 0) {
+            return Fixnum<N>(1);
+        }
+
+        std::vector<bool> composite(static_cast<size_t>(n) + 1, false);
+        std::vector<Fixnum<N>> leaves;
+        uint64_t run = 1;
+
+        for(uint64_t p = 2; p <= n; ++p) {
+            if(composite[p]) {
+                continue;
+            }
+
+            for(uint64_t m = p * p; m <= n; m += p) {
+                composite[m] = true;
+            }
+
+            //p^e never exceeds n, so each prime power is a single factor
+            uint64_t power = 1;
+            for(uint64_t q = p; q <= n; q *= p) {
+                if((n / q) - (k / q) - ((n - k) / q) > 0) {
+                    power *= p;
+                }
+            }
+
+            if(power > 1) {
+                _push_factor(leaves, run, power);
+            }
+        }
+
+        return _leaf_product(leaves, run, threads);
+    }
+}
+
+#endif
@@ -0,0 +1,206 @@
+#ifndef ROOTS_HPP_cb6ca4b332e4e7f908b031f5faff14a4f458a8ca
+#define ROOTS_HPP_cb6ca4b332e4e7f908b031f5faff14a4f458a8ca
+
+#include "Fixnum.hpp"
+#include "Limbs.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace fixnum {
+
+    template<size_t N>
+    void _check_not_negative(const Fixnum<N>& x) {
+        if(x.is_negative()) {
+            throw std::invalid_argument("value must not be negative");
+        }
+    }
+
+    template<size_t N>
+    void _check_positive(const Fixnum<N>& x) {
+        if(x.is_negative() || x == Fixnum<N>(0)) {
+            throw std::invalid_argument("value must be positive");
+        }
+    }
+
+    //floor(sqrt(x)) by Newton's iteration seeded just above the root from the top bit
+    template<size_t N>
+    Fixnum<N> isqrt(const Fixnum<N>& x) {
+        _check_not_negative(x);
+        constexpr int count = limbs::count(Fixnum<N>::bytes);
+        uint32_t a[count], s[count], y[count], q[count], r[count];
+        uint32_t scratch[limbs::divmod_scratch(count, count)];
+        limbs::load(a, count, x.data(), Fixnum<N>::bytes);
+
+        const int bits = limbs::bit_length(a, count);
+        if(bits == 0) {
+            return x;
+        }
+
+        std::fill(s, s + count, 0);
+        s[0] = 1;
+        limbs::shl(s, count, (bits + 1) / 2);
+
+        for(;;) {
+            limbs::divmod(q, r, a, count, s, count, scratch);
+            std::copy(s, s + count, y);
+            limbs::add(y, q, count);
+            limbs::shr(y, count, 1);
+
+            if(limbs::cmp(y, s, count) >= 0) {
+                break;
+            }
+
+            std::copy(y, y + count, s);
+        }
+
+        return limbs::to_fixnum<Fixnum<N>>(s, count);
+    }
+
+    //floor of the k-th root, negative values only have odd roots
+    template<size_t N>
+    Fixnum<N> iroot(const Fixnum<N>& x, const uint32_t k) {
+        if(k == 0) {
+            throw std::invalid_argument("root must be at least 1");
+        }
+
+        if(x.is_negative() && (k & 1) == 0) {
+            throw std::invalid_argument("even root of a negative value");
+        }
+
+        if(k == 1) {
+            return x;
+        }
+
+        if(k == 2) {
+            return isqrt(x);
+        }
+
+        //one spare limb so (k - 1) * s and the running powers never wrap
+        constexpr int count = limbs::count(Fixnum<N>::bytes) + 1;
+        uint32_t a[count], s[count], y[count], p[count], t[count], q[count], r[count];
+        uint32_t scratch[limbs::divmod_scratch(count, count)];
+        limbs::load_magnitude(a, count, x);
+
+        const int bits = limbs::bit_length(a, count);
+        if(bits == 0) {
+            return x;
+        }
+
+        std::fill(s, s + count, 0);
+        s[0] = 1;
+
+        if(k < static_cast<uint32_t>(bits)) {
+            limbs::shl(s, count, (bits + k - 1) / k);
+
+            for(;;) {
+                //p = s^(k-1), stopping as soon as it passes x since x / p is then 0
+                std::fill(p, p + count, 0);
+                p[0] = 1;
+                bool past = false;
+                for(uint32_t i = 1; i < k && !past; ++i) {
+                    //the product has at least this many bits, checked first
+                    //so it is only formed when it fits the spare limb
+                    if(limbs::bit_length(p, count) + limbs::bit_length(s, count) - 1 > bits) {
+                        past = true;
+                        break;
+                    }
+
+                    limbs::mul(t, count, p, count, s, count);
+                    std::copy(t, t + count, p);
+                    past = limbs::bit_length(p, count) > bits;
+                }
+
+                if(past) {
+                    std::fill(q, q + count, 0);
+                }
+                else {
+                    limbs::divmod(q, r, a, count, p, count, scratch);
+                }
+
+                std::copy(s, s + count, y);
+                limbs::mul_1(y, count, k - 1, 0);
+                limbs::add(y, q, count);
+                limbs::divmod_1(y, y, count, k);
+
+                if(limbs::cmp(y, s, count) >= 0) {
+                    break;
+                }
+
+                std::copy(y, y + count, s);
+            }
+        }
+
+        //truncates toward zero like division does
+        const Fixnum<N> root = limbs::to_fixnum<Fixnum<N>>(s, count - 1);
+        return x.is_negative() ? -root : root;
+    }
+
+    template<size_t N>
+    int ilog2(const Fixnum<N>& x) {
+        _check_positive(x);
+        constexpr int count = limbs::count(Fixnum<N>::bytes);
+        uint32_t a[count];
+        limbs::load(a, count, x.data(), Fixnum<N>::bytes);
+        return limbs::bit_length(a, count) - 1;
+    }
+
+    //10^0 up to the first power of ten past 2^N, one spare limb each
+    template<size_t N>
+    const std::vector<uint32_t>& _powers_of_ten() {
+        static const std::vector<uint32_t> table = []() {
+            constexpr int count = limbs::count(Fixnum<N>::bytes) + 1;
+            std::vector<uint32_t> powers(count, 0);
+            powers[0] = 1;
+            while(limbs::bit_length(&powers[powers.size() - count], count) <= static_cast<int>(N)) {
+                powers.resize(powers.size() + count);
+                uint32_t* next = &powers[powers.size() - count];
+                std::copy(next - count, next, next);
+                limbs::mul_1(next, count, 10, 0);
+            }
+
+            return powers;
+        }();
+
+        return table;
+    }
+
+    template<size_t N>
+    int _ilog10_magnitude(const uint32_t* a) {
+        constexpr int count = limbs::count(Fixnum<N>::bytes) + 1;
+        const int bits = limbs::bit_length(a, count);
+
+        //1233 / 4096 is just below log10(2), so this never passes the answer
+        //for 2^(bits-1), the smallest value with this bit length
+        int guess = ((bits - 1) * 1233) >> 12;
+        const std::vector<uint32_t>& powers = _powers_of_ten<N>();
+        while(limbs::cmp(a, &powers[static_cast<size_t>(guess + 1) * count], count) >= 0) {
+            ++guess;
+        }
+
+        return guess;
+    }
+
+    //decimal digits minus one, no string conversion involved
+    template<size_t N>
+    int ilog10(const Fixnum<N>& x) {
+        _check_positive(x);
+        constexpr int count = limbs::count(Fixnum<N>::bytes) + 1;
+        uint32_t a[count];
+        limbs::load(a, count, x.data(), Fixnum<N>::bytes);
+        return _ilog10_magnitude<N>(a);
+    }
+
+    //digits str(10) would print, not counting the sign
+    template<size_t N>
+    int decimal_digits(const Fixnum<N>& x) {
+        constexpr int count = limbs::count(Fixnum<N>::bytes) + 1;
+        uint32_t a[count];
+        limbs::load_magnitude(a, count, x);
+        return limbs::is_zero(a, count) ? 1 : _ilog10_magnitude<N>(a) + 1;
+    }
+}
+
+#endif
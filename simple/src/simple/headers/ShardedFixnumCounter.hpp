@@ -0,0 +1,254 @@
+#ifndef SHARDEDFIXNUMCOUNTER_HPP_98052e35b0dc74ec5424af63a817192f8e417885
+#define SHARDEDFIXNUMCOUNTER_HPP_98052e35b0dc74ec5424af63a817192f8e417885
+
+#include "Allocator.hpp"
+#include "AtomicFixnum.hpp"
+#include "Fixnum.hpp"
+#include "Parallel.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace fixnum {
+
+    //a small number handed to each thread the first time it asks
+    inline unsigned _thread_slot() {
+        static std::atomic<unsigned> next(0);
+        thread_local const unsigned slot = next.fetch_add(1, std::memory_order_relaxed);
+        return slot;
+    }
+
+    //Sum spread over one partial per shard, each on its own cache line.
+    //Partials are 64 bits wider than N, so 2^63 adds of any Fixnum<N> can
+    //pile up in one shard before anything is lost, and they are only merged
+    //when read.
+    //
+    //A shard belongs to the first thread that lands on it, for the life of
+    //the counter. The owner is its only writer, so its adds are plain loads
+    //and stores bracketed by a sequence number, with no locked instruction
+    //and no line shared with another writer. Readers copy the words and retry
+    //if the sequence moved, they never hold up the owner. This scales with
+    //the number of writer threads up to shard_count(). Threads beyond that
+    //find every shard taken and add to a per shard AtomicFixnum instead,
+    //which costs a compare exchange and is shared with whoever else landed
+    //there, so give the counter at least as many shards as adding threads.
+    //Reads take a mutex and walk every shard, they are meant to be rare.
+    template<size_t N>
+    class ShardedFixnumCounter {
+    public:
+        static constexpr size_t wide_bits = N + 64;
+        using Wide = Fixnum<wide_bits>;
+
+        explicit ShardedFixnumCounter(const unsigned shards = default_threads())
+            : _count(shards == 0 ? 1 : shards), _owners(new std::atomic<unsigned>[_count]()), _taken(_count, Wide(0)) {
+            _shards = static_cast<_Shard*>(_aligned_allocate(_count * sizeof(_Shard), cache_line));
+            for(unsigned i = 0; i < _count; ++i) {
+                new (&_shards[i]) _Shard();
+            }
+        }
+
+        ~ShardedFixnumCounter() {
+            for(unsigned i = 0; i < _count; ++i) {
+                _shards[i].~_Shard();
+            }
+
+            _aligned_deallocate(_shards);
+        }
+
+        ShardedFixnumCounter(const ShardedFixnumCounter&) = delete;
+        ShardedFixnumCounter& operator=(const ShardedFixnumCounter&) = delete;
+
+        unsigned shard_count() const {
+            return _count;
+        }
+
+        void add(const Fixnum<N>& f) {
+            _update(f, false);
+        }
+
+        void sub(const Fixnum<N>& f) {
+            _update(f, true);
+        }
+
+        //the exact total, shards are read one after another so adds racing
+        //with the read may or may not be included
+        Wide wide_load() const {
+            std::lock_guard<std::mutex> hold(_reading);
+            Wide total(0);
+            for(unsigned i = 0; i < _count; ++i) {
+                total += _snapshot(_shards[i]) - _taken[i];
+                total += _shards[i].shared.load();
+            }
+
+            return total;
+        }
+
+        //the total wrapped to N bits the way adding Fixnum<N> values would
+        Fixnum<N> load() const {
+            return _narrow(wide_load());
+        }
+
+        //the exact total so far with every shard reset to zero, each add lands
+        //in exactly one snapshot. owned words are never written by a reader,
+        //so what was taken is remembered and left out of later reads instead
+        Wide take() {
+            std::lock_guard<std::mutex> hold(_reading);
+            Wide total(0);
+            for(unsigned i = 0; i < _count; ++i) {
+                const Wide seen = _snapshot(_shards[i]);
+                total += seen - _taken[i];
+                _taken[i] = seen;
+                total += _shards[i].shared.exchange(Wide(0));
+            }
+
+            return total;
+        }
+
+    private:
+        static constexpr int words = (Wide::bytes + 7) / 8;
+
+        struct alignas(cache_line) _Shard {
+            _Shard() : sequence(0) {
+                for(int i = 0; i < words; ++i) {
+                    owned[i].store(0, std::memory_order_relaxed);
+                }
+            }
+
+            std::atomic<uint64_t> sequence;
+            std::atomic<uint64_t> owned[words];
+            AtomicFixnum<wide_bits> shared;
+        };
+
+        //the shard this thread owns, claiming a free one on the way, or
+        //nullptr once every shard has an owner. the last shard found is
+        //remembered per thread and checked against the owners before use,
+        //so the common case is two loads and no division
+        _Shard* _owned_shard(const unsigned slot) {
+            static thread_local const ShardedFixnumCounter* last_counter = nullptr;
+            static thread_local unsigned last_index = 0;
+
+            const unsigned me = slot + 1;
+            if(last_counter == this && last_index < _count &&
+               _owners[last_index].load(std::memory_order_relaxed) == me) {
+                return &_shards[last_index];
+            }
+
+            unsigned at = slot % _count;
+            for(unsigned i = 0; i < _count; ++i) {
+                unsigned owner = _owners[at].load(std::memory_order_relaxed);
+                if(owner == me || (owner == 0 && _owners[at].compare_exchange_strong(owner, me, std::memory_order_relaxed))) {
+                    last_counter = this;
+                    last_index = at;
+                    return &_shards[at];
+                }
+
+                at = at + 1 == _count ? 0 : at + 1;
+            }
+
+            return nullptr;
+        }
+
+        void _update(const Fixnum<N>& f, const bool subtract) {
+            uint64_t v[words];
+            _widen(f, v);
+
+            const unsigned slot = _thread_slot();
+            _Shard* const shard = _owned_shard(slot);
+            if(shard == nullptr) {
+                Wide w;
+                std::memcpy(w.data(), v, Wide::bytes);
+                _Shard& fallback = _shards[slot % _count];
+                if(subtract) {
+                    fallback.shared.fetch_sub(w);
+                }
+                else {
+                    fallback.shared.fetch_add(w);
+                }
+
+                return;
+            }
+
+            //single writer sequence lock: odd while the words are changing
+            const uint64_t sequence = shard->sequence.load(std::memory_order_relaxed);
+            shard->sequence.store(sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            uint64_t current[words];
+            for(int i = 0; i < words; ++i) {
+                current[i] = shard->owned[i].load(std::memory_order_relaxed);
+            }
+
+            _add_words<wide_bits>(current, v, words, subtract);
+            for(int i = 0; i < words; ++i) {
+                shard->owned[i].store(current[i], std::memory_order_relaxed);
+            }
+
+            shard->sequence.store(sequence + 2, std::memory_order_release);
+        }
+
+        static Wide _snapshot(const _Shard& shard) {
+            uint64_t w[words];
+            for(unsigned spins = 0;; ++spins) {
+                const uint64_t before = shard.sequence.load(std::memory_order_acquire);
+                if((before & 1) == 0) {
+                    for(int i = 0; i < words; ++i) {
+                        w[i] = shard.owned[i].load(std::memory_order_relaxed);
+                    }
+
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if(shard.sequence.load(std::memory_order_relaxed) == before) {
+                        break;
+                    }
+                }
+
+                _spin_pause(spins);
+            }
+
+            Wide ret;
+            std::memcpy(ret.data(), w, Wide::bytes);
+            return ret;
+        }
+
+        //sign extension into the words of a wide partial, a word at a time
+        static void _widen(const Fixnum<N>& f, uint64_t* v) {
+            for(int i = 0; i < words; ++i) {
+                v[i] = 0;
+            }
+
+            std::memcpy(v, f.data(), Fixnum<N>::bytes);
+            if(f.is_negative()) {
+                if(N % 64 != 0) {
+                    v[N / 64] |= ~0ULL << (N % 64);
+                }
+
+                for(int i = static_cast<int>((N + 63) / 64); i < words; ++i) {
+                    v[i] = ~0ULL;
+                }
+
+                if(wide_bits % 64 != 0) {
+                    v[words - 1] &= (1ULL << (wide_bits % 64)) - 1;
+                }
+            }
+        }
+
+        static Fixnum<N> _narrow(const Wide& w) {
+            Fixnum<N> f;
+            std::memcpy(f.data(), w.data(), Fixnum<N>::bytes);
+            f.data()[Fixnum<N>::top_index] &= Fixnum<N>::top_mask;
+            return f;
+        }
+
+        unsigned _count;
+        _Shard* _shards;
+        std::unique_ptr<std::atomic<unsigned>[]> _owners;
+        std::vector<Wide> _taken;
+        mutable std::mutex _reading;
+    };
+}
+
+#endif
@@ -0,0 +1,189 @@
+#ifndef SORT_HPP_66004bafd3099e815ff66e3aaa24acd0c57c71eb
+#define SORT_HPP_66004bafd3099e815ff66e3aaa24acd0c57c71eb
+
+#include "Fixnum.hpp"
+#include "Parallel.hpp"
+#include "Span.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace fixnum {
+
+    //past this many keys an msd scatter first leaves buckets small enough for the
+    //lsd passes to stay in cache
+    constexpr size_t radix_msd_grain = 1 << 16;
+
+    //stable lsd passes over bytes [0, last), the sorted keys end up back in keys
+    //and the payload, when present, follows its key
+    template<size_t N, typename T>
+    void _lsd_sort(Fixnum<N>* keys, Fixnum<N>* key_tmp, T* payload, T* payload_tmp, const size_t count, const int last) {
+        //histograms are indexed by the raw byte and all built in one read of the keys
+        std::vector<size_t> histograms(static_cast<size_t>(last) * 256, 0);
+        for(size_t i = 0; i < count; ++i) {
+            const uint8_t* d = keys[i].data();
+            for(int b = 0; b < last; ++b) {
+                ++histograms[(b * 256) + d[b]];
+            }
+        }
+
+        Fixnum<N>* src = keys;
+        Fixnum<N>* dst = key_tmp;
+        T* payload_src = payload;
+        T* payload_dst = payload_tmp;
+
+        for(int b = 0; b < last; ++b) {
+            size_t* histogram = &histograms[b * 256];
+
+            //every key shares this byte, the pass would not move anything
+            if(histogram[src[0].data()[b]] == count) {
+                continue;
+            }
+
+            //walking the raw bytes in flipped order puts the negatives first
+            const int flip = b == Fixnum<N>::top_index ? Fixnum<N>::sign_mask : 0;
+            size_t offset = 0;
+            for(int k = 0; k < 256; ++k) {
+                const size_t c = histogram[k ^ flip];
+                histogram[k ^ flip] = offset;
+                offset += c;
+            }
+
+            for(size_t i = 0; i < count; ++i) {
+                const size_t pos = histogram[src[i].data()[b]]++;
+                dst[pos] = src[i];
+                if(payload) {
+                    payload_dst[pos] = std::move(payload_src[i]);
+                }
+            }
+
+            std::swap(src, dst);
+            std::swap(payload_src, payload_dst);
+        }
+
+        if(src != keys) {
+            std::copy(src, src + count, keys);
+            if(payload) {
+                std::move(payload_src, payload_src + count, payload);
+            }
+        }
+    }
+
+    //splits on the highest byte that is not shared by every key, then finishes the
+    //256 buckets with lsd passes on the bytes below it
+    template<size_t N>
+    void _msd_sort(Span<Fixnum<N>> keys, const unsigned threads) {
+        const size_t count = keys.size();
+        int msd = Fixnum<N>::top_index;
+        for(; msd > 0; --msd) {
+            const uint8_t first = keys[0].data()[msd];
+            size_t i = 1;
+            while(i < count && keys[i].data()[msd] == first) {
+                ++i;
+            }
+
+            if(i < count) {
+                break;
+            }
+        }
+
+        const size_t chunk = (count + threads - 1) / threads;
+        std::vector<Fixnum<N>> tmp(count);
+        std::vector<std::array<size_t, 256>> counts(threads);
+
+        run_threads(threads, [&](const unsigned t) {
+            std::array<size_t, 256>& mine = counts[t];
+            mine.fill(0);
+            const size_t end = std::min(count, (t + 1) * chunk);
+            for(size_t i = t * chunk; i < end; ++i) {
+                ++mine[keys[i].data()[msd]];
+            }
+        });
+
+        //bucket major then thread major keeps the scatter stable
+        const int flip = msd == Fixnum<N>::top_index ? Fixnum<N>::sign_mask : 0;
+        std::array<size_t, 257> bucket_start;
+        size_t offset = 0;
+        for(int k = 0; k < 256; ++k) {
+            bucket_start[k] = offset;
+            for(unsigned t = 0; t < threads; ++t) {
+                const size_t c = counts[t][k ^ flip];
+                counts[t][k ^ flip] = offset;
+                offset += c;
+            }
+        }
+        bucket_start[256] = count;
+
+        run_threads(threads, [&](const unsigned t) {
+            std::array<size_t, 256>& mine = counts[t];
+            const size_t end = std::min(count, (t + 1) * chunk);
+            for(size_t i = t * chunk; i < end; ++i) {
+                tmp[mine[keys[i].data()[msd]]++] = keys[i];
+            }
+        });
+
+        std::atomic<int> next(0);
+        run_threads(threads, [&](const unsigned) {
+            for(int k = next++; k < 256; k = next++) {
+                const size_t begin = bucket_start[k];
+                const size_t size = bucket_start[k + 1] - begin;
+                if(size > 1 && msd > 0) {
+                    _lsd_sort<N, char>(&tmp[begin], keys.data() + begin, nullptr, nullptr, size, msd);
+                }
+
+                std::copy(tmp.begin() + begin, tmp.begin() + begin + size, keys.data() + begin);
+            }
+        });
+    }
+
+    //stable, ascending in the same order as operator<
+    template<size_t N>
+    void radix_sort(Span<Fixnum<N>> keys) {
+        if(keys.size() < 2) {
+            return;
+        }
+
+        if(keys.size() >= radix_msd_grain) {
+            _msd_sort(keys, 1);
+            return;
+        }
+
+        std::vector<Fixnum<N>> tmp(keys.size());
+        _lsd_sort<N, char>(keys.data(), tmp.data(), nullptr, nullptr, keys.size(), Fixnum<N>::bytes);
+    }
+
+    //sorts keys and applies the same permutation to payload
+    template<size_t N, typename T>
+    void radix_sort(Span<Fixnum<N>> keys, Span<T> payload) {
+        if(keys.size() != payload.size()) {
+            throw std::invalid_argument("keys and payload must be the same size");
+        }
+
+        if(keys.size() < 2) {
+            return;
+        }
+
+        std::vector<Fixnum<N>> tmp(keys.size());
+        std::vector<T> payload_tmp(payload.size());
+        _lsd_sort(keys.data(), tmp.data(), payload.data(), payload_tmp.data(), keys.size(), Fixnum<N>::bytes);
+    }
+
+    //the msd scatter is split across threads and the buckets are handed to
+    //whichever thread is free
+    template<size_t N>
+    void parallel_radix_sort(Span<Fixnum<N>> keys, const unsigned threads = default_threads()) {
+        if(threads < 2 || keys.size() < radix_msd_grain) {
+            radix_sort(keys);
+            return;
+        }
+
+        _msd_sort(keys, threads);
+    }
+}
+
+#endif
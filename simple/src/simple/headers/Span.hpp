@@ -0,0 +1,44 @@
+#ifndef SPAN_HPP_a58b55393e328ff886c8916a5daeb8d8095a63fc
+#define SPAN_HPP_a58b55393e328ff886c8916a5daeb8d8095a63fc
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace fixnum {
+
+    //non-owning pointer and length, a stand in for std::span until the build moves past c++14
+    template<typename T>
+    class Span {
+    public:
+        Span() : _ptr(nullptr), _size(0) {}
+
+        Span(T* ptr, const size_t size) : _ptr(ptr), _size(size) {}
+
+        template<typename C,
+                 typename = typename std::enable_if<std::is_convertible<decltype(std::declval<C&>().data()), T*>::value>::type>
+        Span(C& c) : _ptr(c.data()), _size(c.size()) {}
+
+        T* data() const { return _ptr; }
+        T* begin() const { return _ptr; }
+        T* end() const { return _ptr + _size; }
+        size_t size() const { return _size; }
+        bool empty() const { return _size == 0; }
+        T& operator[](const size_t index) const { return _ptr[index]; }
+
+        Span subspan(const size_t offset, const size_t count) const {
+            return Span(_ptr + offset, count);
+        }
+
+    private:
+        T* _ptr;
+        size_t _size;
+    };
+
+    template<typename C>
+    auto make_span(C& c) -> Span<typename std::remove_pointer<decltype(c.data())>::type> {
+        return Span<typename std::remove_pointer<decltype(c.data())>::type>(c.data(), c.size());
+    }
+}
+
+#endif
@@ -0,0 +1,293 @@
+#ifndef STREAM_HPP_5c97f67819248bec27001395b98aa8530b49fc57
+#define STREAM_HPP_5c97f67819248bec27001395b98aa8530b49fc57
+
+#include "Fixnum.hpp"
+#include "FixnumParser.hpp"
+#include "Format.hpp"
+#include "Limbs.hpp"
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+
+#if defined(__has_include) && __cplusplus >= 202002L
+#if __has_include(<format>)
+#include <format>
+#endif
+#endif
+
+//Stream and std::format support. Digits are written into a buffer on the
+//stack and handed over in one piece, nothing is allocated. Like str(base),
+//negative values in every base are a minus sign and the magnitude.
+namespace fixnum {
+
+    //sign, a two character base prefix and the digits of 2^N in base 2
+    template<size_t N>
+    constexpr size_t _text_size() {
+        return N + 4;
+    }
+
+    //digits of |f| in a power of two base, no sign
+    template<size_t N>
+    size_t _format_power_of_two(const Fixnum<N>& f, const int bits, const bool upper, char* out) {
+        constexpr int count = limbs::count(Fixnum<N>::bytes) + 1;
+        uint32_t a[count];
+        limbs::load_magnitude(a, count, f);
+
+        const char* digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+        const uint32_t mask = (1U << bits) - 1;
+        const int length = limbs::bit_length(a, count);
+        const size_t written = length == 0 ? 1 : static_cast<size_t>((length + bits - 1) / bits);
+        char* p = out + written;
+        for(size_t i = 0; i < written; ++i) {
+            const int at = static_cast<int>(i) * bits;
+            const uint64_t window = a[at / 32] | (static_cast<uint64_t>(a[(at / 32) + 1]) << 32);
+            *--p = digits[(window >> (at % 32)) & mask];
+        }
+
+        return written;
+    }
+
+    //digits of |f| in base 2, 8, 10 or 16
+    template<size_t N>
+    size_t _format_digits(const Fixnum<N>& f, const int base, const bool upper, char* out) {
+        switch(base) {
+        case 2: return _format_power_of_two(f, 1, upper, out);
+        case 8: return _format_power_of_two(f, 3, upper, out);
+        case 16: return _format_power_of_two(f, 4, upper, out);
+        default: return _format_magnitude(f, out);
+        }
+    }
+
+    //prefix (sign and base) and digits padded out to width, zero_fill puts
+    //the fill between them
+    template<typename Out>
+    Out _write_padded(Out out, const char* prefix, const size_t prefix_size, const char* digits, const size_t digit_size,
+                      const size_t width, const char fill, const char align) {
+        const size_t size = prefix_size + digit_size;
+        const size_t pad = width > size ? width - size : 0;
+        const size_t before = align == '<' ? 0 : align == '^' ? pad / 2 : align == '=' ? 0 : pad;
+        const size_t between = align == '=' ? pad : 0;
+        const size_t after = pad - before - between;
+
+        for(size_t i = 0; i < before; ++i) *out++ = fill;
+        for(size_t i = 0; i < prefix_size; ++i) *out++ = prefix[i];
+        for(size_t i = 0; i < between; ++i) *out++ = fill;
+        for(size_t i = 0; i < digit_size; ++i) *out++ = digits[i];
+        for(size_t i = 0; i < after; ++i) *out++ = fill;
+        return out;
+    }
+
+    //the sign and the base prefix for f, returns the prefix size
+    template<size_t N>
+    size_t _format_prefix(const Fixnum<N>& f, const char sign, const bool base_prefix, const int base,
+                          const bool upper, char* prefix) {
+        size_t n = 0;
+        if(f.is_negative()) {
+            prefix[n++] = '-';
+        }
+        else if(sign == '+' || sign == ' ') {
+            prefix[n++] = sign;
+        }
+
+        if(base_prefix) {
+            prefix[n++] = '0';
+            if(base == 16) {
+                prefix[n++] = upper ? 'X' : 'x';
+            }
+            else if(base == 2) {
+                prefix[n++] = upper ? 'B' : 'b';
+            }
+        }
+
+        return n;
+    }
+}
+
+//hex and oct follow the basefield flag, width, fill, left, right, internal,
+//showpos, showbase and uppercase are honored as they are for int
+template<size_t N>
+std::ostream& operator<<(std::ostream& os, const Fixnum<N>& f) {
+    std::ostream::sentry ok(os);
+    if(!ok) {
+        return os;
+    }
+
+    const std::ios_base::fmtflags flags = os.flags();
+    const int base = (flags & std::ios_base::basefield) == std::ios_base::hex ? 16 :
+        (flags & std::ios_base::basefield) == std::ios_base::oct ? 8 : 10;
+    const bool upper = (flags & std::ios_base::uppercase) != 0;
+
+    //like int, zero gets no base prefix and the octal 0 counts as a digit
+    //so internal padding goes in front of it
+    char digits[fixnum::_text_size<N>()];
+    size_t digit_size = fixnum::_format_digits(f, base, upper, digits + 1);
+    const bool show_base = (flags & std::ios_base::showbase) != 0 && base != 10 && !(digit_size == 1 && digits[1] == '0');
+    const char* first = digits + 1;
+    if(show_base && base == 8) {
+        digits[0] = '0';
+        --first;
+        ++digit_size;
+    }
+
+    char prefix[4];
+    const size_t prefix_size = fixnum::_format_prefix(f, (flags & std::ios_base::showpos) != 0 ? '+' : '-',
+                                                      show_base && base == 16, base, upper, prefix);
+
+    const std::ios_base::fmtflags adjust = flags & std::ios_base::adjustfield;
+    const char align = adjust == std::ios_base::left ? '<' : adjust == std::ios_base::internal ? '=' : '>';
+    const size_t width = os.width() > 0 ? static_cast<size_t>(os.width()) : 0;
+    os.width(0);
+
+    const std::ostreambuf_iterator<char> done =
+        fixnum::_write_padded(std::ostreambuf_iterator<char>(os), prefix, prefix_size, first, digit_size,
+                              width, os.fill(), align);
+    if(done.failed()) {
+        os.setstate(std::ios_base::badbit);
+    }
+
+    return os;
+}
+
+//reads an optional sign and digits in the basefield base straight off the
+//streambuf, the first other character is left in the stream. failbit is
+//set and f left alone when there are no digits or the value needs more than
+//N bits.
+template<size_t N>
+std::istream& operator>>(std::istream& is, Fixnum<N>& f) {
+    std::istream::sentry ok(is);
+    if(!ok) {
+        return is;
+    }
+
+    const std::ios_base::fmtflags flags = is.flags();
+    const int base = (flags & std::ios_base::basefield) == std::ios_base::hex ? 16 :
+        (flags & std::ios_base::basefield) == std::ios_base::oct ? 8 : 10;
+
+    fixnum::FixnumParser<N> parser(base);
+    std::streambuf* sb = is.rdbuf();
+    char chunk[64];
+    size_t filled = 0;
+    bool first = true;
+    std::ios_base::iostate state = std::ios_base::goodbit;
+    for(;;) {
+        const std::streambuf::int_type c = sb->sgetc();
+        if(std::streambuf::traits_type::eq_int_type(c, std::streambuf::traits_type::eof())) {
+            state |= std::ios_base::eofbit;
+            break;
+        }
+
+        const char ch = std::streambuf::traits_type::to_char_type(c);
+        if(!(first && (ch == '-' || ch == '+')) && fixnum::_digit_value(ch) >= base) {
+            break;
+        }
+
+        chunk[filled++] = ch;
+        first = false;
+        sb->sbumpc();
+        if(filled == sizeof(chunk)) {
+            parser.feed(chunk, chunk + filled);
+            filled = 0;
+        }
+    }
+
+    parser.feed(chunk, chunk + filled);
+    if(parser.finish() == fixnum::ParseStatus::done) {
+        f = parser.value();
+    }
+    else {
+        state |= std::ios_base::failbit;
+    }
+
+    is.setstate(state);
+    return is;
+}
+
+#if defined(__cpp_lib_format)
+namespace std {
+
+//[[fill]align][sign][#][0][width][type] with type one of d, b, B, o, x, X
+template<size_t N>
+struct formatter<Fixnum<N>, char> {
+    char fill = ' ';
+    char align = '>';
+    char sign = '-';
+    bool alternate = false;
+    size_t width = 0;
+    char type = 'd';
+
+    constexpr auto parse(std::format_parse_context& ctx) {
+        auto it = ctx.begin();
+        const auto end = ctx.end();
+        auto is_align = [](const char c) { return c == '<' || c == '>' || c == '^'; };
+
+        bool aligned = true;
+        if(it != end && it + 1 != end && is_align(*(it + 1))) {
+            fill = *it++;
+            align = *it++;
+        }
+        else if(it != end && is_align(*it)) {
+            align = *it++;
+        }
+        else {
+            aligned = false;
+        }
+
+        if(it != end && (*it == '+' || *it == '-' || *it == ' ')) {
+            sign = *it++;
+        }
+
+        if(it != end && *it == '#') {
+            alternate = true;
+            ++it;
+        }
+
+        //as for int, 0 only pads between the sign and the digits when no
+        //alignment was given, otherwise it is ignored
+        if(it != end && *it == '0') {
+            if(!aligned) {
+                fill = '0';
+                align = '=';
+            }
+
+            ++it;
+        }
+
+        while(it != end && *it >= '0' && *it <= '9') {
+            width = (width * 10) + static_cast<size_t>(*it++ - '0');
+        }
+
+        if(it != end && *it != '}') {
+            type = *it++;
+            if(type != 'd' && type != 'b' && type != 'B' && type != 'o' && type != 'x' && type != 'X') {
+                throw std::format_error("invalid type for a fixnum");
+            }
+        }
+
+        if(it != end && *it != '}') {
+            throw std::format_error("invalid format for a fixnum");
+        }
+
+        return it;
+    }
+
+    template<typename Context>
+    auto format(const Fixnum<N>& f, Context& ctx) const {
+        const int base = type == 'b' || type == 'B' ? 2 : type == 'o' ? 8 : type == 'x' || type == 'X' ? 16 : 10;
+        const bool upper = type == 'B' || type == 'X';
+
+        char digits[fixnum::_text_size<N>()];
+        const size_t digit_size = fixnum::_format_digits(f, base, upper, digits);
+
+        //as for int, the octal 0 is not repeated in front of a zero
+        const bool zero = digit_size == 1 && digits[0] == '0';
+        char prefix[4];
+        const size_t prefix_size = fixnum::_format_prefix(f, sign, alternate && base != 10 && !(base == 8 && zero),
+                                                          base, upper, prefix);
+        return fixnum::_write_padded(ctx.out(), prefix, prefix_size, digits, digit_size, width, fill, align);
+    }
+};
+}
+#endif
+
+#endif
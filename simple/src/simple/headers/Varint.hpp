@@ -0,0 +1,328 @@
+#ifndef VARINT_HPP_1a57ffd31fa0acc3c0150caa87a74bcbe5b5524b
+#define VARINT_HPP_1a57ffd31fa0acc3c0150caa87a74bcbe5b5524b
+
+#include "Fixnum.hpp"
+#include "Limbs.hpp"
+#include "Span.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+//Variable length encodings for Fixnum<N>. Values are zigzag mapped first so
+//0, -1, 1, -2, ... become 0, 1, 2, 3, ... and the encoded size follows the
+//magnitude instead of N.
+namespace fixnum {
+
+    template<size_t N>
+    constexpr int max_varint_size() {
+        return static_cast<int>((N + 6) / 7);
+    }
+
+    //zigzag images are kept in scratch rounded up to whole 16 byte chunks
+    template<size_t N>
+    constexpr int _zigzag_size() {
+        return ((Fixnum<N>::bytes + 15) / 16) * 16;
+    }
+
+    template<size_t N>
+    void _zigzag(const Fixnum<N>& f, uint8_t* z) {
+        const uint8_t flip = f.is_negative() ? 0xFF : 0;
+        uint8_t carry = flip & 1;
+        for(int i = 0; i < Fixnum<N>::bytes; ++i) {
+            const uint8_t mask = i == Fixnum<N>::top_index ? Fixnum<N>::top_mask : 0xFF;
+            const uint8_t b = (f.data()[i] ^ flip) & mask;
+            z[i] = static_cast<uint8_t>(b << 1) | carry;
+            carry = b >> 7;
+        }
+
+        std::fill(z + Fixnum<N>::bytes, z + _zigzag_size<N>(), 0);
+    }
+
+    //z must be _zigzag_size<N>() bytes with everything past bit N clear
+    template<size_t N>
+    Fixnum<N> _unzigzag(const uint8_t* z) {
+        constexpr int words = _zigzag_size<N>() / 8;
+        const uint64_t flip = (z[0] & 1) ? ~0ULL : 0;
+        uint64_t out[words];
+        uint64_t next;
+        std::memcpy(&next, z, 8);
+        for(int w = 0; w < words; ++w) {
+            const uint64_t current = next;
+            next = 0;
+            if(w + 1 < words) {
+                std::memcpy(&next, z + ((w + 1) * 8), 8);
+            }
+
+            out[w] = ((current >> 1) | (next << 63)) ^ flip;
+        }
+
+        Fixnum<N> ret;
+        std::memcpy(ret.data(), out, Fixnum<N>::bytes);
+        ret.data()[Fixnum<N>::top_index] &= Fixnum<N>::top_mask;
+        return ret;
+    }
+
+    template<size_t N>
+    void _check_zigzag(const uint8_t* z) {
+        if((z[Fixnum<N>::top_index] & ~Fixnum<N>::top_mask) != 0) {
+            throw std::overflow_error("varint does not fit in fixnum");
+        }
+    }
+
+    inline int _significant_bytes(const uint8_t* z, const int bytes) {
+        int len = bytes;
+        while(len > 0 && z[len - 1] == 0) {
+            --len;
+        }
+
+        return len;
+    }
+
+    template<size_t N>
+    int varint_size(const Fixnum<N>& f) {
+        uint8_t z[_zigzag_size<N>()];
+        _zigzag(f, z);
+        const int len = _significant_bytes(z, Fixnum<N>::bytes);
+        if(len == 0) {
+            return 1;
+        }
+
+        const int bits = (len * 8) - (limbs::leading_zeros(z[len - 1]) - 24);
+        return (bits + 6) / 7;
+    }
+
+    //LEB128 of the zigzag image, out needs room for max_varint_size<N>() bytes,
+    //returns the number of bytes written
+    template<size_t N>
+    int encode_varint(const Fixnum<N>& f, uint8_t* out) {
+        uint8_t z[_zigzag_size<N>()];
+        _zigzag(f, z);
+        const int len = _significant_bytes(z, Fixnum<N>::bytes);
+        int bits = len == 0 ? 1 : (len * 8) - (limbs::leading_zeros(z[len - 1]) - 24);
+
+        int written = 0;
+        uint64_t window = 0;
+        int held = 0;
+        int next = 0;
+        while(bits > 0) {
+            while(held < 7 && next < len) {
+                window |= static_cast<uint64_t>(z[next++]) << held;
+                held += 8;
+            }
+
+            bits -= 7;
+            out[written++] = static_cast<uint8_t>(window & 0x7F) | (bits > 0 ? 0x80 : 0);
+            window >>= 7;
+            held -= 7;
+        }
+
+        return written;
+    }
+
+    //returns the number of bytes consumed, throws std::invalid_argument when the
+    //input ends mid value and std::overflow_error when the value needs more than N bits
+    template<size_t N>
+    size_t decode_varint(const uint8_t* in, const size_t length, Fixnum<N>& out) {
+        uint8_t z[_zigzag_size<N>()] = { 0 };
+        uint64_t window = 0;
+        int held = 0;
+        int filled = 0;
+        size_t i = 0;
+
+        for(;;) {
+            if(i == length) {
+                throw std::invalid_argument("truncated varint");
+            }
+
+            if(i == static_cast<size_t>(max_varint_size<N>())) {
+                throw std::overflow_error("varint does not fit in fixnum");
+            }
+
+            const uint8_t b = in[i++];
+            window |= static_cast<uint64_t>(b & 0x7F) << held;
+            held += 7;
+            while(held >= 8) {
+                if(filled == Fixnum<N>::bytes) {
+                    if((window & 0xFF) != 0) {
+                        throw std::overflow_error("varint does not fit in fixnum");
+                    }
+                }
+                else {
+                    z[filled++] = window & 0xFF;
+                }
+
+                window >>= 8;
+                held -= 8;
+            }
+
+            if((b & 0x80) == 0) {
+                break;
+            }
+        }
+
+        if(window != 0) {
+            if(filled == Fixnum<N>::bytes) {
+                throw std::overflow_error("varint does not fit in fixnum");
+            }
+
+            z[filled] = window & 0xFF;
+        }
+
+        _check_zigzag<N>(z);
+        out = _unzigzag<N>(z);
+        return i;
+    }
+
+    template<size_t N>
+    class VarintWriter {
+    public:
+        explicit VarintWriter(std::vector<uint8_t>& out) : _out(out) {}
+
+        void put(const Fixnum<N>& f) {
+            const size_t at = _out.size();
+            _out.resize(at + max_varint_size<N>());
+            _out.resize(at + encode_varint(f, &_out[at]));
+        }
+
+    private:
+        std::vector<uint8_t>& _out;
+    };
+
+    template<size_t N>
+    class VarintReader {
+    public:
+        VarintReader(const uint8_t* in, const size_t length) : _in(in), _length(length), _position(0) {}
+
+        //false once the input is used up
+        bool next(Fixnum<N>& out) {
+            if(_position == _length) {
+                return false;
+            }
+
+            _position += decode_varint(_in + _position, _length - _position, out);
+            return true;
+        }
+
+        size_t position() const {
+            return _position;
+        }
+
+    private:
+        const uint8_t* _in;
+        size_t _length;
+        size_t _position;
+    };
+
+    //Group varint for bulk work: each run of varint_group values starts with the
+    //byte length of every zigzag image, followed by the images themselves. The
+    //lengths are known up front so decoding is a masked copy per value rather
+    //than a branch per byte.
+    constexpr int varint_group = 8;
+
+    template<size_t N>
+    constexpr int _group_length_bytes() {
+        return Fixnum<N>::bytes < 256 ? 1 : 2;
+    }
+
+    template<size_t N>
+    void encode_group_varints(Span<const Fixnum<N>> values, std::vector<uint8_t>& out) {
+        const int lb = _group_length_bytes<N>();
+        uint8_t z[_zigzag_size<N>()];
+
+        for(size_t start = 0; start < values.size(); start += varint_group) {
+            const size_t count = std::min(values.size() - start, static_cast<size_t>(varint_group));
+            size_t header = out.size();
+            out.resize(header + (count * lb));
+
+            for(size_t j = 0; j < count; ++j) {
+                _zigzag(values[start + j], z);
+                const int len = _significant_bytes(z, Fixnum<N>::bytes);
+                out[header++] = len & 0xFF;
+                if(lb == 2) {
+                    out[header++] = (len >> 8) & 0xFF;
+                }
+
+                out.insert(out.end(), z, z + len);
+            }
+        }
+    }
+
+    //z = the first len bytes of src, zero filled out to _zigzag_size<N>()
+    //src must be readable for _zigzag_size<N>() bytes
+    template<size_t N>
+    void _masked_copy(uint8_t* z, const uint8_t* src, const int len) {
+#if defined(__SSE2__)
+        //a 16 byte window sliding from the 0xFF run into the 0x00 run gives the mask
+        alignas(16) static const uint8_t masks[48] = {
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+        };
+
+        for(int c = 0; c < _zigzag_size<N>(); c += 16) {
+            const int keep = std::max(0, std::min(16, len - c));
+            const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + c));
+            const __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(masks + 32 - keep));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(z + c), _mm_and_si128(data, mask));
+        }
+#else
+        std::memcpy(z, src, _zigzag_size<N>());
+        std::memset(z + len, 0, _zigzag_size<N>() - len);
+#endif
+    }
+
+    //returns the number of bytes consumed
+    template<size_t N>
+    size_t decode_group_varints(const uint8_t* in, const size_t length, Span<Fixnum<N>> out) {
+        const int lb = _group_length_bytes<N>();
+        const uint8_t* p = in;
+        const uint8_t* end = in + length;
+        uint8_t z[_zigzag_size<N>()];
+
+        for(size_t start = 0; start < out.size(); start += varint_group) {
+            const size_t count = std::min(out.size() - start, static_cast<size_t>(varint_group));
+            const uint8_t* header = p;
+            if(static_cast<size_t>(end - p) < count * lb) {
+                throw std::invalid_argument("truncated group varint");
+            }
+
+            p += count * lb;
+            for(size_t j = 0; j < count; ++j) {
+                int len = header[j * lb];
+                if(lb == 2) {
+                    len |= header[(j * lb) + 1] << 8;
+                }
+
+                if(len > Fixnum<N>::bytes) {
+                    throw std::overflow_error("varint does not fit in fixnum");
+                }
+
+                if(end - p < len) {
+                    throw std::invalid_argument("truncated group varint");
+                }
+
+                if(end - p >= _zigzag_size<N>()) {
+                    _masked_copy<N>(z, p, len);
+                }
+                else {
+                    std::memset(z, 0, sizeof(z));
+                    std::memcpy(z, p, len);
+                }
+
+                _check_zigzag<N>(z);
+                out[start + j] = _unzigzag<N>(z);
+                p += len;
+            }
+        }
+
+        return p - in;
+    }
+}
+
+#endif
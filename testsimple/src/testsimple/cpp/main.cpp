@@ -1,11 +1,37 @@
 #include "Decode.hpp"
 #include "Fixnum.hpp"
+#include "ProductTree.hpp"
+#include "Gcd.hpp"
+#include "Pow.hpp"
+#include "Roots.hpp"
+#include "Hash.hpp"
+#include "Sort.hpp"
+#include "Keys.hpp"
+#include "Bytes.hpp"
+#include "FixnumView.hpp"
+#include "FixnumFile.hpp"
+#include "Varint.hpp"
+#include "FixnumColumn.hpp"
+#include "PackedFixnumArray.hpp"
+#include "FixnumParser.hpp"
+#include "Hex.hpp"
+#include "Format.hpp"
+#include "Encoding.hpp"
+#include "Float.hpp"
+#include "Stream.hpp"
+#include "AtomicFixnum.hpp"
+#include "ShardedFixnumCounter.hpp"
+#include "FixnumAccumulator.hpp"
+#include "Allocator.hpp"
 #include <iostream>
 #include <cassert>
 #include <algorithm>
 #include <limits>
 #include <chrono>
 #include <climits>
+#include <unordered_map>
+#include <sstream>
+#include <mutex>
 
 #define NDEBUG 1
 
@@ -702,6 +728,2530 @@ void test_int_adds() {
     assert((bit32(25) % 4).str() == "1");
 }
 
+void test_product_tree() {
+    using bit512 = Fixnum<512>;
+
+    assert(fixnum::factorial<128>(0) == Fixnum<128>(1));
+    assert(fixnum::factorial<128>(1) == Fixnum<128>(1));
+    assert(fixnum::factorial<128>(20).str() == "2432902008176640000");
+    assert(fixnum::factorial<512>(50).str() == "30414093201713378043612608166064768844377641568960512000000000000");
+    assert(fixnum::factorial<512>(50, 4) == fixnum::factorial<512>(50, 1));
+    assert(fixnum::factorial<64>(20) == bit64(static_cast<int64_t>(2432902008176640000L)));
+
+    assert(fixnum::binomial<256>(100, 50).str() == "100891344545564193334812497256");
+    assert(fixnum::binomial<256>(100, 0) == Fixnum<256>(1));
+    assert(fixnum::binomial<256>(5, 6) == Fixnum<256>(0));
+    assert(fixnum::binomial<32>(10, 3) == bit32(120));
+
+    std::vector<bit512> values;
+    bit512 folded(1);
+    for(int i = 1; i <= 200; ++i) {
+        values.push_back(bit512(i * 7 - 300));
+        folded *= values.back();
+    }
+
+    assert(fixnum::product(values.data(), values.size(), 1) == folded);
+    assert(fixnum::product(fixnum::Span<const bit512>(values), 8) == folded);
+    assert(fixnum::product<512>(nullptr, 0) == bit512(1));
+
+    Fixnum<4096> big_fold(1);
+    for(int i = 2; i <= 400; ++i) {
+        big_fold *= Fixnum<4096>(i);
+    }
+    assert(fixnum::factorial<4096>(400, 4) == big_fold);
+}
+
+//positive values with the top few bits clear, filled from a small lcg
+template<size_t N>
+Fixnum<N> random_fixnum(uint64_t& state, const int used_bits = N - 1) {
+    Fixnum<N> ret;
+    for(int i = 0; i < Fixnum<N>::bytes; ++i) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        ret.data()[i] = static_cast<uint8_t>(state >> 56);
+    }
+
+    for(int i = used_bits; i < static_cast<int>(N); ++i) {
+        ret.bit(i, false);
+    }
+
+    ret.data()[Fixnum<N>::top_index] &= Fixnum<N>::top_mask;
+    return ret;
+}
+
+template<size_t N>
+Fixnum<N> euclid_gcd(Fixnum<N> a, Fixnum<N> b) {
+    if(a.is_negative()) a = -a;
+    if(b.is_negative()) b = -b;
+    while(b != Fixnum<N>(0)) {
+        Fixnum<N> t = a % b;
+        a = b;
+        b = t;
+    }
+
+    return a;
+}
+
+void test_gcd() {
+    using bit512 = Fixnum<512>;
+    using namespace fixnum;
+
+    assert(gcd(bit32(12), bit32(18)) == bit32(6));
+    assert(gcd(bit32(-12), bit32(18)) == bit32(6));
+    assert(gcd(bit32(0), bit32(-18)) == bit32(18));
+    assert(gcd(bit32(0), bit32(0)) == bit32(0));
+    assert(gcd(bit8(100), bit8(75)) == bit8(25));
+    assert(gcd(Fixnum<77>(1071), Fixnum<77>(462)) == Fixnum<77>(21));
+    assert(lcm(bit64(21), bit64(6)) == bit64(42));
+    assert(lcm(Fixnum<128>(-4), Fixnum<128>(6)) == Fixnum<128>(12));
+    assert(lcm(Fixnum<128>(0), Fixnum<128>(6)) == Fixnum<128>(0));
+
+    uint64_t state = 17;
+    for(int i = 0; i < 20; ++i) {
+        const Fixnum<128> g = random_fixnum<128>(state, 40);
+        const Fixnum<128> a = g * random_fixnum<128>(state, 80);
+        const Fixnum<128> b = g * random_fixnum<128>(state, 80);
+        assert(gcd(a, b) == euclid_gcd(a, b));
+
+        const bit512 wg = random_fixnum<512>(state, 100);
+        const bit512 wa = wg * random_fixnum<512>(state, 400);
+        const bit512 wb = wg * random_fixnum<512>(state, 380);
+        const bit512 expected = euclid_gcd(wa, wb);
+        assert(gcd(wa, wb) == expected);
+        assert(gcd(wb, -wa) == expected);
+
+        const std::array<bit512,3> ext = xgcd(wa, -wb);
+        assert(ext[0] == expected);
+        assert(wa * ext[1] + (-wb) * ext[2] == expected);
+    }
+
+    assert(xgcd(bit32(240), bit32(46))[0] == bit32(2));
+    assert(bit32(240) * xgcd(bit32(240), bit32(46))[1] + bit32(46) * xgcd(bit32(240), bit32(46))[2] == bit32(2));
+
+    assert(mod_inverse(bit32(3), bit32(11)) == bit32(4));
+    assert(mod_inverse(bit32(-3), bit32(11)) == bit32(7));
+    const bit512 p("170141183460469231731687303715884105727", 10);
+    const bit512 v("123456789012345678901234567890", 10);
+    assert((mod_inverse(v, p) * v) % p == bit512(1));
+
+    try {
+        mod_inverse(bit32(6), bit32(9));
+        assert(false);
+    }
+    catch(std::invalid_argument& e) {
+        assert(true);
+    }
+}
+
+template<size_t N>
+void bench_gcd_width(const int rounds) {
+    using namespace std::chrono;
+
+    uint64_t state = N;
+    std::vector<Fixnum<N>> values;
+    for(int i = 0; i < rounds * 2; ++i) {
+        values.push_back(random_fixnum<N>(state));
+    }
+
+    auto start = system_clock::now();
+    Fixnum<N> sink;
+    for(int i = 0; i < rounds; ++i) {
+        sink ^= fixnum::gcd(values[2*i], values[2*i + 1]);
+    }
+    auto end = system_clock::now();
+    std::cout << "gcd " << N << ": " << sink.fsb() << " " << nanoseconds(end - start).count() / rounds << std::endl;
+
+    if(N <= 512) {
+        start = system_clock::now();
+        for(int i = 0; i < rounds; ++i) {
+            sink ^= euclid_gcd(values[2*i], values[2*i + 1]);
+        }
+        end = system_clock::now();
+        std::cout << "euclid gcd " << N << ": " << sink.fsb() << " " << nanoseconds(end - start).count() / rounds << std::endl;
+    }
+}
+
+void bench_gcd() {
+    bench_gcd_width<256>(20);
+    bench_gcd_width<512>(10);
+    bench_gcd_width<1024>(5);
+    bench_gcd_width<2048>(3);
+    bench_gcd_width<4096>(2);
+}
+
+template<size_t N>
+Fixnum<N> naive_pow_mod(Fixnum<N> base, Fixnum<N> exp, const Fixnum<N>& mod) {
+    Fixnum<N> result(1);
+    base %= mod;
+    while(exp != Fixnum<N>(0)) {
+        if(exp[0]) {
+            result = (result * base) % mod;
+        }
+
+        base = (base * base) % mod;
+        exp >>= 1;
+    }
+
+    return result % mod;
+}
+
+void test_pow() {
+    using bit256 = Fixnum<256>;
+    using namespace fixnum;
+
+    assert(pow(bit64(3), 39) == bit64(static_cast<int64_t>(4052555153018976267L)));
+    assert(pow(bit256(3), 100).str() == "515377520732011331036461129765621272702107522001");
+    assert(pow(bit256(-3), 3) == bit256(-27));
+    assert(pow(bit256(-3), 4) == bit256(81));
+    assert(pow(bit256(12345), 0) == bit256(1));
+    assert(pow(bit256(0), 5) == bit256(0));
+    assert(pow(bit32(2), 31) == bit32::lowest());
+    assert(pow(bit16(7), 3) == bit16(343));
+    assert(square(bit256(-123456789)) == bit256(static_cast<int64_t>(15241578750190521L)));
+
+    assert(pow<100>(bit256(3)) == pow(bit256(3), 100));
+    assert(pow<0>(bit256(3)) == bit256(1));
+    assert(pow<1>(bit256(-3)) == bit256(-3));
+    assert(pow<13>(Fixnum<77>(-5)) == pow(Fixnum<77>(-5), 13));
+
+    assert(pow_mod(bit32(4), bit32(13), bit32(497)) == bit32(445));
+    assert(pow_mod(bit32(-4), bit32(13), bit32(497)) == bit32(52));
+    assert(pow_mod(bit32(4), bit32(0), bit32(1)) == bit32(0));
+    assert(pow_mod(bit32(4), bit32(0), bit32(7)) == bit32(1));
+
+    //fermat on the mersenne prime 2^127 - 1
+    const bit256 p = pow(bit256(2), 127) - bit256(1);
+    assert(pow_mod(bit256(3), p - bit256(1), p) == bit256(1));
+    assert(pow_mod(bit256(123456789), p - bit256(1), p) == bit256(1));
+
+    uint64_t state = 99;
+    const Fixnum<512> m = random_fixnum<512>(state, 250);
+    const Fixnum<512> base = random_fixnum<512>(state, 511);
+    const PowModTable<512> table(base, m, 4);
+    for(int i = 0; i < 3; ++i) {
+        const Fixnum<512> e = random_fixnum<512>(state, 200);
+        const Fixnum<512> expected = naive_pow_mod(base, e, m);
+        assert(table.pow(e) == expected);
+        assert(pow_mod(base, e, m) == expected);
+    }
+
+    try {
+        pow_mod(bit32(4), bit32(-1), bit32(7));
+        assert(false);
+    }
+    catch(std::invalid_argument& e) {
+        assert(true);
+    }
+}
+
+template<size_t N>
+void bench_pow_mod_width(const int rounds, const bool naive) {
+    using namespace std::chrono;
+
+    uint64_t state = N + 1;
+    const Fixnum<N> m = random_fixnum<N>(state, N / 2 - 1);
+    const Fixnum<N> base = random_fixnum<N>(state, N / 2 - 2);
+    const Fixnum<N> e = random_fixnum<N>(state, N - 2);
+
+    auto start = system_clock::now();
+    Fixnum<N> sink;
+    for(int i = 0; i < rounds; ++i) {
+        sink ^= fixnum::pow_mod(base, e, m);
+    }
+    auto end = system_clock::now();
+    std::cout << "pow_mod " << N << ": " << sink.fsb() << " " << nanoseconds(end - start).count() / rounds << std::endl;
+
+    if(naive) {
+        start = system_clock::now();
+        sink = naive_pow_mod(base, e, m);
+        end = system_clock::now();
+        std::cout << "naive pow_mod " << N << ": " << sink.fsb() << " " << nanoseconds(end - start).count() << std::endl;
+    }
+}
+
+void bench_pow_mod() {
+    bench_pow_mod_width<256>(20, true);
+    bench_pow_mod_width<512>(5, true);
+    bench_pow_mod_width<2048>(1, false);
+}
+
+//every 10^k and 10^k - 1 that fits, where the bit length estimate is tightest
+template<size_t N>
+void check_powers_of_ten() {
+    using F = Fixnum<N>;
+    const F ten(10);
+    F power(1);
+    for(int k = 0; ; ++k) {
+        assert(fixnum::ilog10(power) == k);
+        assert(fixnum::decimal_digits(power) == static_cast<int>(power.str().size()));
+        assert(fixnum::decimal_digits(-power) == static_cast<int>(power.str().size()));
+        if(k > 0) {
+            const F below = power - F(1);
+            assert(fixnum::ilog10(below) == k - 1);
+            assert(fixnum::decimal_digits(below) == static_cast<int>(below.str().size()));
+        }
+
+        if(power > F::max() / ten) {
+            break;
+        }
+
+        power *= ten;
+    }
+
+    assert(fixnum::decimal_digits(F::max()) == static_cast<int>(F::max().str().size()));
+    assert(fixnum::decimal_digits(F::lowest()) == static_cast<int>(F::lowest().str().size()) - 1);
+}
+
+void test_roots() {
+    using bit512 = Fixnum<512>;
+    using namespace fixnum;
+
+    assert(isqrt(bit32(0)) == bit32(0));
+    assert(isqrt(bit32(1)) == bit32(1));
+    assert(isqrt(bit32(15)) == bit32(3));
+    assert(isqrt(bit32(16)) == bit32(4));
+    assert(isqrt(bit32::max()) == bit32(46340));
+    assert(isqrt(bit8(100)) == bit8(10));
+    assert(isqrt(pow(bit512(10), 100)) == pow(bit512(10), 50));
+
+    uint64_t state = 3;
+    for(int i = 0; i < 20; ++i) {
+        const bit512 x = random_fixnum<512>(state, 10 + i * 25);
+        const bit512 r = isqrt(x);
+        assert(r * r <= x && (r + bit512(1)) * (r + bit512(1)) > x);
+
+        const bit512 c = iroot(x, 3);
+        assert(pow(c, 3) <= x && pow(c + bit512(1), 3) > x);
+    }
+
+    assert(iroot(bit32(27), 3) == bit32(3));
+    assert(iroot(bit32(26), 3) == bit32(2));
+    assert(iroot(bit32(-27), 3) == bit32(-3));
+    assert(iroot(bit32(1000), 1) == bit32(1000));
+    assert(iroot(bit32(1000), 40) == bit32(1));
+    assert(iroot(pow(bit512(2), 500), 5) == pow(bit512(2), 100));
+    assert(iroot(pow(bit512(2), 500) - bit512(1), 5) == pow(bit512(2), 100) - bit512(1));
+    assert(iroot(Fixnum<64>::lowest(), 3) == Fixnum<64>(-2097152));
+
+    //wide values near the top bit with mid sized roots, where s^(k-1) * s
+    //would not fit the working limbs
+    using bit4096 = Fixnum<4096>;
+    for(int bits = 4080; bits <= 4094; ++bits) {
+        const bit4096 x = pow(bit4096(2), bits) + pow(bit4096(2), bits - 3);
+        for(uint32_t k : { 61u, 87u, 97u, 127u, 255u }) {
+            const bit4096 c = iroot(x, k);
+            assert(pow(c, k) <= x && pow(c + bit4096(1), k) > x);
+        }
+    }
+
+    assert(iroot(pow(bit4096(2), 4089), 87) == bit4096(2) * pow(bit4096(2), 4089 / 87 - 1));
+
+    assert(ilog2(bit32(1)) == 0);
+    assert(ilog2(bit32(1024)) == 10);
+    assert(ilog2(bit16(0x100)) == 8);
+    assert(ilog2(bit512::max()) == 510);
+
+    assert(ilog10(bit32(1)) == 0);
+    assert(ilog10(bit32(9)) == 0);
+    assert(ilog10(bit32(10)) == 1);
+    assert(ilog10(bit32(999)) == 2);
+    assert(ilog10(bit32(1000)) == 3);
+    assert(ilog10(bit32::max()) == 9);
+    assert(ilog10(pow(bit512(10), 150)) == 150);
+    assert(ilog10(pow(bit512(10), 150) - bit512(1)) == 149);
+
+    assert(decimal_digits(bit32(0)) == 1);
+    assert(decimal_digits(bit32(-1000)) == 4);
+    assert(decimal_digits(bit8::lowest()) == 3);
+    for(int i = 0; i < 20; ++i) {
+        const bit512 x = random_fixnum<512>(state, 1 + i * 25);
+        assert(decimal_digits(x) == static_cast<int>(x.str().size()));
+    }
+
+    assert(ilog10(pow(Fixnum<1024>(10), 205)) == 205);
+    check_powers_of_ten<1024>();
+    check_powers_of_ten<4096>();
+
+    try {
+        ilog10(bit32(0));
+        assert(false);
+    }
+    catch(std::invalid_argument& e) {
+        assert(true);
+    }
+}
+
+void bench_roots() {
+    using namespace std::chrono;
+    using bit512 = Fixnum<512>;
+
+    uint64_t state = 5;
+    const bit512 x = random_fixnum<512>(state, 500);
+
+    auto start = system_clock::now();
+    bit512 newton = fixnum::isqrt(x);
+    auto end = system_clock::now();
+    std::cout << "isqrt newton: " << nanoseconds(end - start).count() << std::endl;
+
+    start = system_clock::now();
+    bit512 low(0), high = bit512(1) << 251;
+    while(low < high) {
+        const bit512 mid = (low + high + bit512(1)) >> 1;
+        if(mid * mid <= x) low = mid;
+        else high = mid - bit512(1);
+    }
+    end = system_clock::now();
+    std::cout << "isqrt binary search: " << nanoseconds(end - start).count() << std::endl;
+    assert(low == newton);
+
+    start = system_clock::now();
+    int digits = fixnum::decimal_digits(x);
+    end = system_clock::now();
+    std::cout << "decimal_digits: " << digits << " " << nanoseconds(end - start).count() << std::endl;
+
+    start = system_clock::now();
+    digits = x.str().size();
+    end = system_clock::now();
+    std::cout << "str().size(): " << digits << " " << nanoseconds(end - start).count() << std::endl;
+}
+
+struct ThrowingCopy {
+    static bool fail;
+    static int live;
+
+    ThrowingCopy() { ++live; }
+    ThrowingCopy(const ThrowingCopy&) {
+        if(fail) {
+            throw std::runtime_error("copy failed");
+        }
+
+        ++live;
+    }
+
+    ThrowingCopy(ThrowingCopy&&) { ++live; }
+    ~ThrowingCopy() { --live; }
+};
+
+bool ThrowingCopy::fail = false;
+int ThrowingCopy::live = 0;
+
+void test_hash() {
+    using bit128 = Fixnum<128>;
+
+    assert(fixnum::hash(bit128(12345)) == fixnum::hash(bit128("12345", 10)));
+    assert(fixnum::hash(bit128(12345)) != fixnum::hash(bit128(12346)));
+    assert(fixnum::hash(bit128(1)) != fixnum::hash(bit128(1) << 64));
+    assert(std::hash<bit32>()(bit32(7)) == std::hash<bit32>()(bit32(7)));
+    assert(fixnum::hash(Fixnum<20>(-1)) == fixnum::hash(Fixnum<20>(-2) + Fixnum<20>(1)));
+
+    std::unordered_map<bit128, int> standard;
+    standard[bit128(5)] = 5;
+    standard[bit128(-5)] = -5;
+    assert(standard[bit128(5)] == 5 && standard[bit128(-5)] == -5 && standard.size() == 2);
+
+    fixnum::FixnumMap<128, int> map;
+    assert(map.find(bit128(1)) == nullptr);
+    assert(map.insert(bit128(1), 10).second);
+    assert(!map.insert(bit128(1), 11).second);
+    assert(*map.find(bit128(1)) == 10);
+    map[bit128(2)] = 20;
+    assert(map[bit128(2)] == 20 && map.size() == 2);
+    assert(map.erase(bit128(1)) && !map.erase(bit128(1)));
+    assert(!map.contains(bit128(1)) && map.size() == 1);
+
+    uint64_t state = 11;
+    std::unordered_map<bit128, int> reference;
+    reference[bit128(2)] = 20;
+    std::vector<bit128> keys;
+    for(int i = 0; i < 5000; ++i) {
+        keys.push_back(random_fixnum<128>(state, 20 + (i % 100)));
+        map[keys.back()] = i;
+        reference[keys.back()] = i;
+    }
+
+    for(int i = 0; i < 5000; i += 3) {
+        assert(map.erase(keys[i]) == (reference.erase(keys[i]) == 1));
+    }
+
+    for(int i = 0; i < 2000; ++i) {
+        keys.push_back(random_fixnum<128>(state, 64));
+        map.insert(keys.back(), -i);
+        reference.insert(std::make_pair(keys.back(), -i));
+    }
+
+    assert(map.size() == reference.size());
+    for(const bit128& k : keys) {
+        const auto it = reference.find(k);
+        const int* found = map.find(k);
+        assert((it == reference.end()) == (found == nullptr));
+        assert(found == nullptr || *found == it->second);
+    }
+
+    size_t visited = 0;
+    map.for_each([&](const bit128& k, const int& v) { assert(reference.at(k) == v); ++visited; });
+    assert(visited == reference.size());
+
+    fixnum::FixnumMap<128, int> moved(std::move(map));
+    assert(moved.size() == reference.size() && map.size() == 0);
+    moved.clear();
+    assert(moved.empty() && moved.find(keys[1]) == nullptr);
+
+    //a copy that throws must leave no half built slot behind
+    {
+        fixnum::FixnumMap<128, ThrowingCopy> guarded;
+        ThrowingCopy value;
+        for(int i = 0; i < 100; ++i) {
+            guarded.insert(bit128(i), value);
+        }
+
+        ThrowingCopy::fail = true;
+        try {
+            guarded.insert(bit128(1000), value);
+            assert(false);
+        }
+        catch(std::runtime_error& e) {
+            assert(true);
+        }
+
+        ThrowingCopy::fail = false;
+        assert(guarded.size() == 100 && !guarded.contains(bit128(1000)));
+        assert(ThrowingCopy::live == 101);
+        assert(guarded.insert(bit128(1000), value).second && guarded.size() == 101);
+    }
+
+    assert(ThrowingCopy::live == 0);
+
+    //keys and values handed back from the map stay valid while it grows
+    fixnum::FixnumMap<128, std::string> chained;
+    chained.insert(bit128(0), std::string(40, 'x'));
+    for(int i = 1; i < 500; ++i) {
+        const std::pair<std::string*, bool> added = chained.insert(bit128(i), *chained.find(bit128(i - 1)));
+        assert(added.second && *added.first == std::string(40, 'x'));
+    }
+
+    assert(chained.size() == 500);
+}
+
+void bench_hash() {
+    using namespace std::chrono;
+    using bit128 = Fixnum<128>;
+
+    uint64_t state = 21;
+    std::vector<bit128> keys;
+    for(int i = 0; i < 20000; ++i) {
+        keys.push_back(random_fixnum<128>(state));
+    }
+
+    auto start = system_clock::now();
+    std::unordered_map<std::string, int> by_string;
+    for(size_t i = 0; i < keys.size(); ++i) {
+        by_string[keys[i].str()] = i;
+    }
+    long found = 0;
+    for(const bit128& k : keys) {
+        found += by_string[k.str()];
+    }
+    auto end = system_clock::now();
+    std::cout << "unordered_map by str(): " << found << " " << nanoseconds(end - start).count() << std::endl;
+
+    start = system_clock::now();
+    fixnum::FixnumMap<128, int> flat;
+    for(size_t i = 0; i < keys.size(); ++i) {
+        flat[keys[i]] = i;
+    }
+    found = 0;
+    for(const bit128& k : keys) {
+        found += *flat.find(k);
+    }
+    end = system_clock::now();
+    std::cout << "FixnumMap: " << found << " " << nanoseconds(end - start).count() << std::endl;
+}
+
+template<size_t N>
+std::vector<Fixnum<N>> random_signed_keys(uint64_t& state, const size_t count, const int used_bits = N - 1) {
+    std::vector<Fixnum<N>> keys;
+    for(size_t i = 0; i < count; ++i) {
+        Fixnum<N> k = random_fixnum<N>(state, used_bits);
+        keys.push_back((i % 3) == 0 ? -k : k);
+    }
+
+    return keys;
+}
+
+template<size_t N>
+void check_radix_sort(uint64_t& state, const size_t count, const int used_bits = N - 1) {
+    std::vector<Fixnum<N>> keys = random_signed_keys<N>(state, count, used_bits);
+    std::vector<Fixnum<N>> expected = keys;
+    std::sort(expected.begin(), expected.end());
+
+    fixnum::radix_sort(fixnum::make_span(keys));
+    assert(keys == expected);
+}
+
+void test_radix_sort() {
+    using bit128 = Fixnum<128>;
+    uint64_t state = 33;
+
+    check_radix_sort<20>(state, 1000);
+    check_radix_sort<32>(state, 1000);
+    check_radix_sort<64>(state, 1000);
+    check_radix_sort<128>(state, 1000);
+    check_radix_sort<128>(state, 1000, 16);
+    check_radix_sort<4096>(state, 200);
+
+    std::vector<bit128> edges { bit128::max(), bit128(0), bit128::lowest(), bit128(-1), bit128(1) };
+    fixnum::radix_sort(fixnum::make_span(edges));
+    assert(edges[0] == bit128::lowest() && edges[1] == bit128(-1) && edges[2] == bit128(0));
+    assert(edges[3] == bit128(1) && edges[4] == bit128::max());
+
+    std::vector<bit128> keys = random_signed_keys<128>(state, 5000, 8);
+    std::vector<int> payload;
+    std::vector<std::pair<bit128, int>> expected;
+    for(size_t i = 0; i < keys.size(); ++i) {
+        payload.push_back(i);
+        expected.push_back(std::make_pair(keys[i], static_cast<int>(i)));
+    }
+
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](const std::pair<bit128, int>& a, const std::pair<bit128, int>& b) { return a.first < b.first; });
+    fixnum::radix_sort(fixnum::make_span(keys), fixnum::make_span(payload));
+    for(size_t i = 0; i < keys.size(); ++i) {
+        assert(keys[i] == expected[i].first && payload[i] == expected[i].second);
+    }
+
+    std::vector<int> short_payload(3);
+    try {
+        fixnum::radix_sort(fixnum::make_span(keys), fixnum::make_span(short_payload));
+        assert(false);
+    }
+    catch(const std::invalid_argument&) {}
+
+    keys = random_signed_keys<128>(state, fixnum::radix_msd_grain + 1000);
+    std::vector<bit128> sorted = keys;
+    std::sort(sorted.begin(), sorted.end());
+    fixnum::parallel_radix_sort(fixnum::make_span(keys), 4);
+    assert(keys == sorted);
+
+    //the msd split lands below the top byte when the high bytes are all equal
+    keys.clear();
+    for(size_t i = 0; i < fixnum::radix_msd_grain; ++i) {
+        keys.push_back(random_fixnum<128>(state, 40));
+    }
+    sorted = keys;
+    std::sort(sorted.begin(), sorted.end());
+    fixnum::parallel_radix_sort(fixnum::make_span(keys), 3);
+    assert(keys == sorted);
+
+    check_radix_sort<8>(state, fixnum::radix_msd_grain);
+}
+
+template<size_t N>
+void check_sortable_keys(uint64_t& state) {
+    const int size = fixnum::sortable_key_size<N>();
+    std::vector<Fixnum<N>> values = random_signed_keys<N>(state, 200);
+    values.push_back(Fixnum<N>::max());
+    values.push_back(Fixnum<N>::lowest());
+    values.push_back(Fixnum<N>(0));
+    values.push_back(Fixnum<N>(-1));
+
+    std::vector<uint8_t> encoded(values.size() * size);
+    fixnum::encode_sortable_keys(fixnum::Span<const Fixnum<N>>(values.data(), values.size()), encoded.data());
+
+    for(size_t i = 0; i < values.size(); ++i) {
+        for(size_t j = 0; j < values.size(); ++j) {
+            const int c = std::memcmp(&encoded[i * size], &encoded[j * size], size);
+            assert((c < 0) == (values[i] < values[j]));
+            assert((c == 0) == (values[i] == values[j]));
+        }
+    }
+
+    std::vector<Fixnum<N>> decoded(values.size());
+    fixnum::decode_sortable_keys(encoded.data(), fixnum::make_span(decoded));
+    assert(decoded == values);
+}
+
+void test_sortable_keys() {
+    uint64_t state = 35;
+    check_sortable_keys<12>(state);
+    check_sortable_keys<16>(state);
+    check_sortable_keys<64>(state);
+    check_sortable_keys<128>(state);
+    check_sortable_keys<257>(state);
+
+    uint8_t key[2];
+    fixnum::encode_sortable_key(Fixnum<12>(-5), key);
+    assert(key[0] == 0x07 && key[1] == 0xFB);
+    key[0] = 0x10;
+    try {
+        fixnum::decode_sortable_key<12>(key);
+        assert(false);
+    }
+    catch(const std::invalid_argument&) {}
+}
+
+template<size_t N>
+void check_byte_order(uint64_t& state) {
+    const int bytes = Fixnum<N>::bytes;
+    std::vector<Fixnum<N>> values = random_signed_keys<N>(state, 50);
+    std::vector<uint8_t> le(values.size() * bytes);
+    std::vector<uint8_t> be(values.size() * bytes);
+    const fixnum::Span<const Fixnum<N>> view(values.data(), values.size());
+    fixnum::to_bytes_le(view, le.data());
+    fixnum::to_bytes_be(view, be.data());
+
+    for(size_t i = 0; i < values.size(); ++i) {
+        for(int b = 0; b < bytes; ++b) {
+            assert(le[(i * bytes) + b] == values[i].byte(b));
+            assert(be[(i * bytes) + bytes - b - 1] == values[i].byte(b));
+        }
+
+        assert(fixnum::from_bytes_le<N>(&le[i * bytes], bytes) == values[i]);
+        assert(fixnum::from_bytes_be<N>(&be[i * bytes], bytes) == values[i]);
+    }
+
+    std::vector<Fixnum<N>> from_le(values.size());
+    std::vector<Fixnum<N>> from_be(values.size());
+    fixnum::from_bytes_le(le.data(), fixnum::make_span(from_le));
+    fixnum::from_bytes_be(be.data(), fixnum::make_span(from_be));
+    assert(from_le == values && from_be == values);
+}
+
+void test_byte_order() {
+    using bit256 = Fixnum<256>;
+    uint64_t state = 36;
+    check_byte_order<12>(state);
+    check_byte_order<64>(state);
+    check_byte_order<256>(state);
+    check_byte_order<1000>(state);
+
+    const uint8_t packet[] = { 0x01, 0x02, 0x03 };
+    assert(fixnum::from_bytes_be<256>(packet, 3) == bit256(0x010203));
+    assert(fixnum::from_bytes_le<256>(packet, 3) == bit256(0x030201));
+    assert(fixnum::from_bytes_le<256>(fixnum::Span<const uint8_t>(packet, 2)) == bit256(0x0201));
+
+    std::vector<uint8_t> wide(40, 0xFF);
+    assert(fixnum::from_bytes_le<12>(wide.data(), 2) == Fixnum<12>(-1));
+    try {
+        fixnum::from_bytes_le<256>(wide.data(), wide.size());
+        assert(false);
+    }
+    catch(const std::overflow_error&) {}
+
+    fixnum::to_bytes_be(bit256(0x0A0B), fixnum::make_span(wide));
+    assert(wide[30] == 0x0A && wide[31] == 0x0B && wide[0] == 0 && wide[32] == 0xFF);
+    try {
+        fixnum::to_bytes_le(bit256(1), fixnum::Span<uint8_t>(wide.data(), 31));
+        assert(false);
+    }
+    catch(const std::overflow_error&) {}
+}
+
+template<size_t N>
+void check_fixnum_view(uint64_t& state) {
+    using F = Fixnum<N>;
+    const int bytes = F::bytes;
+    std::vector<F> values = random_signed_keys<N>(state, 40, N - 2);
+
+    //odd offset so nothing lines up with the fixnum alignment
+    std::vector<uint8_t> buffer(1 + (values.size() * bytes));
+    fixnum::to_bytes_le(fixnum::Span<const F>(values.data(), values.size()), buffer.data() + 1);
+
+    for(size_t i = 0; i + 1 < values.size(); ++i) {
+        fixnum::FixnumView<N> a(buffer.data() + 1 + (i * bytes));
+        const fixnum::ConstFixnumView<N> b(buffer.data() + 1 + ((i + 1) * bytes));
+        const F x = values[i];
+        const F y = values[i + 1];
+
+        assert(a.value() == x && b == y && y == b && a.str() == x.str());
+        assert((a < b) == (x < y) && (a <= b) == (x <= y) && (a > b) == (x > y) && (a >= b) == (x >= y));
+        assert((a == b) == (x == y) && (a != b) == (x != y) && a.is_negative() == x.is_negative());
+
+        a += b; assert(a == x + y);
+        a -= b; assert(a == x);
+        a -= y; assert(a == x - y);
+        a += y;
+        a *= b; assert(a == x * y);
+        a.assign(x);
+        a ^= b; assert(a == (x ^ y));
+        a |= b; assert(a == ((x ^ y) | y));
+        a &= b; assert(a == (((x ^ y) | y) & y));
+        a.assign(x);
+        if(y != F(0)) {
+            a /= b; assert(a == x / y);
+            a.assign(x);
+            a %= b; assert(a == x % y);
+            a.assign(x);
+        }
+        a.negate(); assert(a == -x);
+        a.negate(); ++a; assert(a == x + F(1));
+        --a; a <<= 3; assert(a == (x << 3));
+        a.assign(x);
+        a >>= 5; assert(a == (x >> 5));
+        a.assign(x);
+        a.bit(0, !x.bit(0)); assert(a.bit(0) == !x.bit(0));
+        a.assign(x);
+    }
+
+    std::vector<F> back(values.size());
+    fixnum::from_bytes_le(buffer.data() + 1, fixnum::make_span(back));
+    assert(back == values);
+}
+
+void test_fixnum_view() {
+    uint64_t state = 37;
+    check_fixnum_view<20>(state);
+    check_fixnum_view<64>(state);
+    check_fixnum_view<256>(state);
+    check_fixnum_view<300>(state);
+
+    Fixnum<256> owned(41);
+    fixnum::FixnumView<256> view(owned);
+    ++view;
+    assert(owned == Fixnum<256>(42) && view.is_zero() == false);
+
+    Fixnum<256> max = Fixnum<256>::max();
+    fixnum::FixnumView<256> wraps(max);
+    ++wraps;
+    assert(max == Fixnum<256>::lowest());
+}
+
+void test_fixnum_file() {
+    using bit256 = Fixnum<256>;
+    const char* path = "fixnum_file_test.bin";
+    uint64_t state = 38;
+    const std::vector<bit256> values = random_signed_keys<256>(state, 1000);
+
+    {
+        fixnum::FixnumFileWriter<256> writer(path);
+        writer.write(values[0]);
+        writer.write(fixnum::Span<const bit256>(values.data() + 1, values.size() - 1));
+        assert(writer.count() == values.size());
+    }
+
+    {
+        fixnum::MappedFixnumArray<256> mapped(path);
+        assert(mapped.size() == values.size());
+        assert(reinterpret_cast<uintptr_t>(mapped.data()) % 64 == 0);
+        for(size_t i = 0; i < values.size(); ++i) {
+            assert(mapped[i] == values[i] && mapped.value(i) == values[i]);
+        }
+    }
+
+    try {
+        fixnum::MappedFixnumArray<128> narrow(path);
+        assert(false);
+    }
+    catch(const std::runtime_error&) {}
+
+    //flip one element byte and the checksum has to notice
+    std::FILE* f = std::fopen(path, "r+b");
+    std::fseek(f, fixnum::file_data_offset + 100, SEEK_SET);
+    std::fputc(~values[3].byte(4) & 0xFF, f);
+    std::fclose(f);
+    try {
+        fixnum::MappedFixnumArray<256> corrupt(path);
+        assert(false);
+    }
+    catch(const std::runtime_error&) {}
+    fixnum::MappedFixnumArray<256> unchecked(path, false);
+    assert(unchecked.size() == values.size());
+
+    {
+        fixnum::FixnumFileWriter<20> empty(path);
+    }
+    fixnum::MappedFixnumArray<20> nothing(path);
+    assert(nothing.empty());
+
+    std::remove(path);
+}
+
+void bench_fixnum_file() {
+    using namespace std::chrono;
+    using bit256 = Fixnum<256>;
+    const char* path = "fixnum_file_bench.bin";
+
+    uint64_t state = 39;
+    std::vector<std::string> text;
+    {
+        fixnum::FixnumFileWriter<256> writer(path);
+        for(int i = 0; i < 20000; ++i) {
+            const bit256 value = random_fixnum<256>(state);
+            text.push_back(value.str());
+            writer.write(value);
+        }
+    }
+
+    auto start = system_clock::now();
+    std::vector<bit256> parsed;
+    for(const std::string& s : text) {
+        parsed.push_back(bit256(s, 10));
+    }
+    auto end = system_clock::now();
+    std::cout << "load from decimal: " << nanoseconds(end - start).count() << std::endl;
+
+    start = system_clock::now();
+    fixnum::MappedFixnumArray<256> mapped(path);
+    end = system_clock::now();
+    std::cout << "load mapped: " << nanoseconds(end - start).count() << std::endl;
+
+    for(size_t i = 0; i < parsed.size(); ++i) {
+        assert(mapped[i] == parsed[i]);
+    }
+
+    std::remove(path);
+}
+
+template<size_t N>
+std::vector<Fixnum<N>> mixed_magnitudes(uint64_t& state, const size_t count) {
+    std::vector<Fixnum<N>> values;
+    for(size_t i = 0; i < count; ++i) {
+        const int bits = 1 + static_cast<int>(i % (N - 1));
+        Fixnum<N> v = random_fixnum<N>(state, bits);
+        values.push_back((i % 2) == 0 ? -v : v);
+    }
+
+    values.push_back(Fixnum<N>::max());
+    values.push_back(Fixnum<N>::lowest());
+    values.push_back(Fixnum<N>(0));
+    return values;
+}
+
+template<size_t N>
+void check_varint(uint64_t& state) {
+    const std::vector<Fixnum<N>> values = mixed_magnitudes<N>(state, 300);
+
+    std::vector<uint8_t> stream;
+    fixnum::VarintWriter<N> writer(stream);
+    for(const Fixnum<N>& v : values) {
+        uint8_t single[fixnum::max_varint_size<N>()];
+        const int written = fixnum::encode_varint(v, single);
+        assert(written == fixnum::varint_size(v) && written <= fixnum::max_varint_size<N>());
+        Fixnum<N> back;
+        assert(fixnum::decode_varint(single, written, back) == static_cast<size_t>(written) && back == v);
+        writer.put(v);
+    }
+
+    fixnum::VarintReader<N> reader(stream.data(), stream.size());
+    Fixnum<N> next;
+    for(const Fixnum<N>& v : values) {
+        assert(reader.next(next) && next == v);
+    }
+    assert(!reader.next(next) && reader.position() == stream.size());
+
+    std::vector<uint8_t> grouped;
+    fixnum::encode_group_varints(fixnum::Span<const Fixnum<N>>(values.data(), values.size()), grouped);
+    std::vector<Fixnum<N>> decoded(values.size());
+    assert(fixnum::decode_group_varints(grouped.data(), grouped.size(), fixnum::make_span(decoded)) == grouped.size());
+    assert(decoded == values);
+
+    try {
+        fixnum::decode_group_varints(grouped.data(), grouped.size() - 1, fixnum::make_span(decoded));
+        assert(false);
+    }
+    catch(const std::invalid_argument&) {}
+}
+
+void test_varint() {
+    using bit256 = Fixnum<256>;
+    uint64_t state = 40;
+    check_varint<8>(state);
+    check_varint<20>(state);
+    check_varint<64>(state);
+    check_varint<256>(state);
+    check_varint<2100>(state);
+
+    assert(fixnum::varint_size(bit256(0)) == 1 && fixnum::varint_size(bit256(-1)) == 1);
+    assert(fixnum::varint_size(bit256(63)) == 1 && fixnum::varint_size(bit256(64)) == 2);
+    assert(fixnum::varint_size(bit256(-64)) == 1 && fixnum::varint_size(bit256(-65)) == 2);
+
+    uint8_t encoded[fixnum::max_varint_size<64>()];
+    const int written = fixnum::encode_varint(bit64(300), encoded);
+    assert(written == 2 && encoded[0] == 0xD8 && encoded[1] == 0x04);
+
+    Fixnum<8> narrow;
+    try {
+        fixnum::decode_varint(encoded, written, narrow);
+        assert(false);
+    }
+    catch(const std::overflow_error&) {}
+
+    try {
+        fixnum::decode_varint(encoded, 1, narrow);
+        assert(false);
+    }
+    catch(const std::invalid_argument&) {}
+}
+
+void bench_varint() {
+    using namespace std::chrono;
+    using bit256 = Fixnum<256>;
+
+    uint64_t state = 41;
+    std::vector<bit256> values;
+    for(int i = 0; i < 200000; ++i) {
+        const bit256 v = random_fixnum<256>(state, 1 + (i % 48));
+        values.push_back((i % 3) == 0 ? -v : v);
+    }
+
+    auto start = system_clock::now();
+    std::vector<uint8_t> stream;
+    fixnum::VarintWriter<256> writer(stream);
+    for(const bit256& v : values) {
+        writer.put(v);
+    }
+    std::vector<bit256> decoded(values.size());
+    fixnum::VarintReader<256> reader(stream.data(), stream.size());
+    for(bit256& v : decoded) {
+        reader.next(v);
+    }
+    auto end = system_clock::now();
+    std::cout << "varint: " << stream.size() << " " << nanoseconds(end - start).count() << std::endl;
+    assert(decoded == values);
+
+    std::vector<uint8_t> grouped;
+    start = system_clock::now();
+    fixnum::encode_group_varints(fixnum::Span<const bit256>(values.data(), values.size()), grouped);
+    fixnum::decode_group_varints(grouped.data(), grouped.size(), fixnum::make_span(decoded));
+    end = system_clock::now();
+    std::cout << "group varint: " << grouped.size() << " " << nanoseconds(end - start).count() << std::endl;
+    assert(decoded == values);
+}
+
+template<size_t N>
+void check_column(const std::vector<Fixnum<N>>& values, const fixnum::ColumnMode mode) {
+    const fixnum::FixnumColumn<N> column(fixnum::Span<const Fixnum<N>>(values.data(), values.size()), mode);
+    assert(column.size() == values.size());
+    assert(column.block_count() == (values.size() + fixnum::column_block - 1) / fixnum::column_block);
+
+    std::vector<Fixnum<N>> decoded(values.size());
+    column.decode(fixnum::make_span(decoded));
+    assert(decoded == values);
+
+    for(size_t i = 0; i < values.size(); i += 7) {
+        assert(column.get(i) == values[i]);
+    }
+}
+
+void test_fixnum_column() {
+    using bit128 = Fixnum<128>;
+    using fixnum::ColumnMode;
+    uint64_t state = 42;
+
+    std::vector<bit128> timestamps;
+    bit128 now = bit128(int64_t(1) << 60) * bit128(1000);
+    for(int i = 0; i < 1000; ++i) {
+        now += random_fixnum<128>(state, 10);
+        timestamps.push_back(now);
+    }
+
+    const fixnum::FixnumColumn<128> by_delta(fixnum::Span<const bit128>(timestamps.data(), timestamps.size()));
+    assert(by_delta.block_mode(0) == ColumnMode::delta && by_delta.block_width(0) <= 10);
+    assert(by_delta.compressed_bytes() < timestamps.size() * 4);
+    check_column(timestamps, ColumnMode::automatic);
+    check_column(timestamps, ColumnMode::frame_of_reference);
+    check_column(timestamps, ColumnMode::delta);
+
+    std::vector<bit128> clustered;
+    for(int i = 0; i < 777; ++i) {
+        clustered.push_back(bit128(-5000000) + random_fixnum<128>(state, 20));
+    }
+    const fixnum::FixnumColumn<128> by_reference(fixnum::Span<const bit128>(clustered.data(), clustered.size()));
+    assert(by_reference.block_mode(0) == ColumnMode::frame_of_reference && by_reference.block_width(0) <= 20);
+    check_column(clustered, ColumnMode::automatic);
+    check_column(clustered, ColumnMode::delta);
+
+    std::vector<bit128> extremes { bit128::max(), bit128::lowest(), bit128(0), bit128::max(), bit128(-1) };
+    const fixnum::FixnumColumn<128> wide(fixnum::Span<const bit128>(extremes.data(), extremes.size()), ColumnMode::frame_of_reference);
+    assert(wide.block_width(0) == 128);
+    check_column(extremes, ColumnMode::automatic);
+    check_column(extremes, ColumnMode::delta);
+
+    check_column(random_signed_keys<20>(state, 300), ColumnMode::automatic);
+    check_column(random_signed_keys<64>(state, 300, 40), ColumnMode::automatic);
+    check_column(random_signed_keys<300>(state, 300, 200), ColumnMode::delta);
+    check_column(std::vector<bit128>(300, bit128(77)), ColumnMode::automatic);
+    check_column(std::vector<bit128>(), ColumnMode::automatic);
+}
+
+void bench_fixnum_column() {
+    using namespace std::chrono;
+    using bit128 = Fixnum<128>;
+
+    uint64_t state = 43;
+    std::vector<bit128> timestamps;
+    bit128 now(int64_t(1) << 50);
+    for(int i = 0; i < 1000000; ++i) {
+        now += random_fixnum<128>(state, 12);
+        timestamps.push_back(now);
+    }
+
+    const fixnum::FixnumColumn<128> column(fixnum::Span<const bit128>(timestamps.data(), timestamps.size()));
+    std::vector<bit128> decoded(timestamps.size());
+
+    auto start = system_clock::now();
+    std::copy(timestamps.begin(), timestamps.end(), decoded.begin());
+    auto end = system_clock::now();
+    std::cout << "column raw copy: " << timestamps.size() * 16 << " " << nanoseconds(end - start).count() << std::endl;
+
+    start = system_clock::now();
+    column.decode(fixnum::make_span(decoded));
+    end = system_clock::now();
+    std::cout << "column decode: " << column.compressed_bytes() << " " << nanoseconds(end - start).count() << std::endl;
+    assert(decoded == timestamps);
+}
+
+template<size_t N>
+void check_packed_array(uint64_t& state) {
+    using F = Fixnum<N>;
+    const size_t count = 333;
+    const std::vector<F> a = random_signed_keys<N>(state, count);
+    std::vector<F> b = random_signed_keys<N>(state, count);
+    b[0] = F::max();
+    b[1] = F::lowest();
+
+    fixnum::PackedFixnumArray<N> pa(fixnum::Span<const F>(a.data(), a.size()));
+    fixnum::PackedFixnumArray<N> pb(fixnum::Span<const F>(b.data(), b.size()));
+    assert(pa.size() == count && pa.bytes() == (((count * N) + 63) / 64 + 1) * 8);
+    for(size_t i = 0; i < count; ++i) {
+        assert(pa[i] == a[i] && pb.get(i) == b[i]);
+    }
+
+    fixnum::PackedFixnumArray<N> sum = pa;
+    sum += pb;
+    fixnum::PackedFixnumArray<N> diff = pa;
+    diff -= pb;
+    fixnum::PackedFixnumArray<N> mixed = pa;
+    mixed ^= pb;
+    for(size_t i = 0; i < count; ++i) {
+        assert(sum.get(i) == a[i] + b[i]);
+        assert(diff.get(i) == a[i] - b[i]);
+        assert(mixed.get(i) == (a[i] ^ b[i]));
+    }
+
+    std::vector<F> unpacked(count - 10);
+    pa.unpack(10, fixnum::make_span(unpacked));
+    assert(std::equal(unpacked.begin(), unpacked.end(), a.begin() + 10));
+
+    pa[5] = b[7];
+    pa[6] = pb[8];
+    pa[7] += F(1);
+    assert(pa.get(5) == b[7] && F(pa[6]) == b[8] && pa.get(7) == a[7] + F(1));
+    assert(pa.get(4) == a[4] && pa.get(8) == a[8]);
+
+    pa.resize(3);
+    pa.resize(5);
+    assert(pa.get(2) == a[2] && pa.get(3) == F(0) && pa.get(4) == F(0));
+    pa.push_back(F(-3));
+    assert(pa.size() == 6 && pa.at(5) == F(-3));
+}
+
+void test_packed_array() {
+    uint64_t state = 44;
+    check_packed_array<12>(state);
+    check_packed_array<40>(state);
+    check_packed_array<64>(state);
+    check_packed_array<100>(state);
+    check_packed_array<127>(state);
+
+    fixnum::PackedFixnumArray<40> packed;
+    for(int i = -50; i < 50; ++i) {
+        packed.push_back(Fixnum<40>(int64_t(i) * 1000000000));
+    }
+    std::vector<int64_t> native(packed.size());
+    packed.unpack(0, fixnum::make_span(native));
+    for(int i = 0; i < 100; ++i) {
+        assert(native[i] == int64_t(i - 50) * 1000000000);
+    }
+
+    fixnum::PackedFixnumArray<40> other(3);
+    try {
+        packed += other;
+        assert(false);
+    }
+    catch(const std::invalid_argument&) {}
+
+    try {
+        packed.at(100);
+        assert(false);
+    }
+    catch(const std::overflow_error&) {}
+}
+
+void bench_packed_array() {
+    using namespace std::chrono;
+    using bit40 = Fixnum<40>;
+
+    uint64_t state = 45;
+    const std::vector<bit40> a = random_signed_keys<40>(state, 1000000);
+    const std::vector<bit40> b = random_signed_keys<40>(state, 1000000);
+
+    std::vector<bit40> plain = a;
+    auto start = system_clock::now();
+    for(size_t i = 0; i < plain.size(); ++i) {
+        plain[i] += b[i];
+    }
+    auto end = system_clock::now();
+    std::cout << "vector<Fixnum<40>> add: " << plain.size() * sizeof(bit40) << " " << nanoseconds(end - start).count() << std::endl;
+
+    fixnum::PackedFixnumArray<40> pa(fixnum::Span<const bit40>(a.data(), a.size()));
+    const fixnum::PackedFixnumArray<40> pb(fixnum::Span<const bit40>(b.data(), b.size()));
+    start = system_clock::now();
+    pa += pb;
+    end = system_clock::now();
+    std::cout << "PackedFixnumArray<40> add: " << pa.bytes() << " " << nanoseconds(end - start).count() << std::endl;
+
+    for(size_t i = 0; i < plain.size(); i += 1000) {
+        assert(pa.get(i) == plain[i]);
+    }
+}
+
+template<size_t N>
+Fixnum<N> parse_all(const std::string& text, const int base = 10, fixnum::ParseStatus expected = fixnum::ParseStatus::done) {
+    fixnum::FixnumParser<N> parser(base);
+    parser.feed(text.data(), text.data() + text.size());
+    assert(parser.finish() == expected);
+    return parser.value();
+}
+
+void test_fixnum_parser() {
+    using bit256 = Fixnum<256>;
+    using fixnum::ParseStatus;
+
+    //every split point of the text has to give the same answer
+    const std::string text = "-115792089237316195423570985008687907853269984665640564039457584007913129639";
+    const bit256 expected = parse_all<256>(text);
+    assert(expected.str() == text);
+    for(size_t split = 0; split <= text.size(); ++split) {
+        fixnum::FixnumParser<256> parser;
+        assert(parser.feed(text.data(), text.data() + split) == text.data() + split);
+        assert(parser.status() == ParseStatus::more);
+        parser.feed(text.data() + split, text.data() + text.size());
+        assert(parser.finish() == ParseStatus::done && parser.value() == expected);
+    }
+
+    //one character at a time across several numbers
+    const std::string stream = "  12\n-340282366920938463463374607431768211455 +7\t0 ";
+    const std::vector<std::string> numbers { "12", "-340282366920938463463374607431768211455", "7", "0" };
+    fixnum::FixnumParser<256> parser;
+    std::vector<bit256> parsed;
+    for(size_t i = 0; i < stream.size(); ) {
+        const char* stop = parser.feed(stream.data() + i, stream.data() + i + 1);
+        i = stop - stream.data();
+        if(parser.status() == ParseStatus::done) {
+            parsed.push_back(parser.value());
+            parser.reset();
+        }
+    }
+    assert(parser.finish() == ParseStatus::invalid);
+    assert(parsed.size() == numbers.size());
+    for(size_t i = 0; i < numbers.size(); ++i) {
+        assert(parsed[i].str() == (numbers[i][0] == '+' ? numbers[i].substr(1) : numbers[i]));
+    }
+
+    assert(parse_all<8>("127") == bit8(127) && parse_all<8>("-128") == bit8::lowest());
+    parse_all<8>("128", 10, ParseStatus::overflow);
+    parse_all<8>("-129", 10, ParseStatus::overflow);
+    assert(parse_all<12>("-2048") == Fixnum<12>::lowest() && parse_all<12>("2047") == Fixnum<12>::max());
+    parse_all<12>("2048", 10, ParseStatus::overflow);
+    parse_all<64>("99999999999999999999999999999999999999", 10, ParseStatus::overflow);
+    assert(parse_all<64>("-9223372036854775808") == bit64::lowest());
+
+    assert(parse_all<128>("-ff", 16) == Fixnum<128>(-255));
+    assert(parse_all<128>("Zz", 36) == Fixnum<128>(35 * 36 + 35));
+    assert(parse_all<128>("101", 2) == Fixnum<128>(5));
+    assert(parse_all<128>("1239", 9) == Fixnum<128>(1 * 81 + 2 * 9 + 3));
+
+    parse_all<128>("-", 10, ParseStatus::invalid);
+    parse_all<128>("", 10, ParseStatus::invalid);
+    parse_all<128>("x1", 10, ParseStatus::invalid);
+    parse_all<128>("1", 37, ParseStatus::invalid);
+
+    fixnum::FixnumParser<128> stops;
+    const std::string csv = "42,7";
+    assert(stops.feed(csv.data(), csv.data() + csv.size()) == csv.data() + 2);
+    assert(stops.status() == ParseStatus::done && stops.value() == Fixnum<128>(42));
+}
+
+void test_digit_kernels() {
+    using namespace decode;
+
+    const char* digits = "1234567890123456";
+    uint32_t high = 0, low = 0;
+    assert(try_parse_8_digits(digits, low) && low == 12345678);
+    assert(try_parse_16_digits(digits, high, low) && high == 12345678 && low == 90123456);
+    assert(try_parse_16_digits("0000000099999999", high, low) && high == 0 && low == 99999999);
+
+    //every position, with the characters on either side of the digit range
+    const char outside[] = { '/', ':', ' ', 'a', '\0', static_cast<char>(0xB0) };
+    for(int at = 0; at < 16; ++at) {
+        for(const char c : outside) {
+            char text[17];
+            std::memcpy(text, digits, 17);
+            text[at] = c;
+            assert(!try_parse_16_digits(text, high, low));
+            assert(try_parse_8_digits(text, low) == (at >= 8));
+        }
+    }
+
+    uint64_t state = 46;
+    for(int i = 0; i < 1000; ++i) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        const uint32_t value = (state >> 32) % 100000000;
+        char text[9];
+        std::snprintf(text, sizeof(text), "%08u", value);
+        assert(parse_8_digits(load_8_chars(text)) == value);
+    }
+}
+
+void bench_decimal_parse() {
+    using namespace std::chrono;
+    using bit256 = Fixnum<256>;
+
+    uint64_t state = 47;
+    std::vector<std::string> text;
+    std::string joined;
+    for(int i = 0; i < 20000; ++i) {
+        text.push_back(random_fixnum<256>(state).str());
+        joined += text.back();
+        joined += '\n';
+    }
+
+    auto start = system_clock::now();
+    std::vector<bit256> constructed;
+    for(const std::string& s : text) {
+        constructed.push_back(bit256(s, 10));
+    }
+    auto end = system_clock::now();
+    std::cout << "decimal constructor: " << nanoseconds(end - start).count() << std::endl;
+
+    start = system_clock::now();
+    std::vector<bit256> parsed;
+    fixnum::FixnumParser<256> parser;
+    const char* p = joined.data();
+    const char* stop = joined.data() + joined.size();
+    while(p != stop) {
+        p = parser.feed(p, stop);
+        if(parser.status() == fixnum::ParseStatus::done) {
+            parsed.push_back(parser.value());
+            parser.reset();
+        }
+    }
+    end = system_clock::now();
+    std::cout << "decimal parser: " << nanoseconds(end - start).count() << std::endl;
+
+    assert(parsed == constructed);
+}
+
+template<size_t N>
+void check_hex(uint64_t& state) {
+    using F = Fixnum<N>;
+    for(int i = 0; i < 300; ++i) {
+        const F f = random_fixnum<N>(state);
+        const F n = f.complement();
+        assert(F(f.str(16), 16) == f);
+        assert(F(n.str(16), 16) == n);
+        assert(F(f.str(16), 16) == F(f.str(10), 10));
+
+        std::string lower = f.str(16);
+        std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+        assert(F(std::string("+000") + lower, 16) == f);
+
+        const std::string fixed = fixnum::to_hex(f);
+        assert(fixed.size() == fixnum::hex_size<N>());
+        assert(fixnum::from_hex<N>(fixed.data()) == f);
+        assert(fixnum::from_hex<N>(fixnum::to_hex(n, false).data()) == n);
+    }
+
+    assert(F("", 16) == F(0));
+    assert(F("-", 16) == F(0));
+    assert(F("-0", 16) == F(0));
+    assert(F(0).str(16) == "0");
+}
+
+void test_hex() {
+    using namespace decode;
+
+    //the kernels against a byte at a time reference, over every tail length
+    uint64_t state = 48;
+    for(size_t n = 0; n < 100; ++n) {
+        std::vector<uint8_t> bytes(n);
+        for(uint8_t& b : bytes) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            b = static_cast<uint8_t>(state >> 56);
+        }
+
+        std::string expected;
+        for(size_t i = n; i > 0; --i) {
+            char pair[3];
+            std::snprintf(pair, sizeof(pair), "%02x", bytes[i - 1]);
+            expected += pair;
+        }
+
+        std::string out(2 * n, ' ');
+        hex_encode(bytes.data(), n, &out[0], false);
+        assert(out == expected);
+
+        std::vector<uint8_t> back(n);
+        assert(hex_decode(out.data(), n, back.data()) && back == bytes);
+
+        std::transform(out.begin(), out.end(), out.begin(), ::toupper);
+        assert(hex_decode(out.data(), n, back.data()) && back == bytes);
+
+        for(size_t at = 0; at < 2 * n; at += 7) {
+            std::string bad = out;
+            bad[at] = "g/:@G`\0"[at % 7];
+            assert(!hex_decode(bad.data(), n, back.data()));
+        }
+    }
+
+    //anything that is not hex keeps the old digit by digit behaviour
+    assert(Fixnum<32>("1g", 16) == Fixnum<32>(16));
+    assert(Fixnum<32>("-ff", 16) == Fixnum<32>(-255));
+
+    bool threw = false;
+    try { fixnum::from_hex<12>("F000"); } catch(const std::overflow_error&) { threw = true; }
+    assert(threw);
+
+    threw = false;
+    try { fixnum::from_hex<16>("00x0"); } catch(const std::invalid_argument&) { threw = true; }
+    assert(threw);
+
+    check_hex<8>(state);
+    check_hex<12>(state);
+    check_hex<16>(state);
+    check_hex<32>(state);
+    check_hex<64>(state);
+    check_hex<128>(state);
+    check_hex<256>(state);
+    check_hex<300>(state);
+    check_hex<1024>(state);
+}
+
+void bench_hex() {
+    using namespace std::chrono;
+    using bit1024 = Fixnum<1024>;
+
+    uint64_t state = 49;
+    std::vector<bit1024> values;
+    for(int i = 0; i < 2000; ++i) {
+        values.push_back(random_fixnum<1024>(state));
+    }
+
+    auto start = system_clock::now();
+    std::vector<std::string> converted;
+    for(const bit1024& f : values) {
+        uint8_t pos_hex[2 * bit1024::bytes];
+        for(int j = 0; j < bit1024::bytes; ++j) {
+            pos_hex[2 * j] = f.data()[j] & 0xF;
+            pos_hex[(2 * j) + 1] = f.data()[j] >> 4;
+        }
+        converted.push_back(decode::convert_pos_str<2 * bit1024::bytes>(pos_hex, 16));
+    }
+    auto end = system_clock::now();
+    std::cout << "hex convert_pos_str: " << nanoseconds(end - start).count() << std::endl;
+
+    start = system_clock::now();
+    std::vector<std::string> text;
+    for(const bit1024& f : values) {
+        text.push_back(f.str(16));
+    }
+    end = system_clock::now();
+    std::cout << "hex str: " << nanoseconds(end - start).count() << std::endl;
+    assert(text == converted);
+
+    start = system_clock::now();
+    std::vector<bit1024> slow;
+    for(const std::string& s : text) {
+        slow.push_back(bit1024(decode::ConvertBase<uint8_t>(s, 16, 16)));
+    }
+    end = system_clock::now();
+    std::cout << "hex ConvertBase: " << nanoseconds(end - start).count() << std::endl;
+
+    start = system_clock::now();
+    std::vector<bit1024> parsed;
+    for(const std::string& s : text) {
+        parsed.push_back(bit1024(s, 16));
+    }
+    end = system_clock::now();
+    std::cout << "hex constructor: " << nanoseconds(end - start).count() << std::endl;
+    assert(parsed == values && slow == values);
+}
+
+template<size_t N>
+void check_format(uint64_t& state) {
+    using F = Fixnum<N>;
+    std::vector<F> values = { F(0), F(1), F(-1), F(9), F(10), F::lowest(), F::max() };
+    for(int i = 0; i < 200; ++i) {
+        values.push_back(random_fixnum<N>(state));
+        values.push_back(values.back().complement());
+    }
+
+    std::string expected;
+    for(const F& f : values) {
+        char text[fixnum::max_decimal_size<N>()];
+        const size_t n = fixnum::format_decimal(f, text);
+        assert(std::string(text, n) == f.str());
+        expected += (expected.empty() ? "" : ",") + f.str();
+    }
+
+    fixnum::OutputBuffer out;
+    fixnum::format_many<N>(values, ',', out);
+    assert(out.str() == expected);
+
+    std::vector<char> fixed(expected.size() + fixnum::max_decimal_size<N>() * values.size());
+    fixnum::OutputBuffer into(fixed.data(), fixed.size());
+    fixnum::format_many<N>(values, ',', into);
+    assert(into.str() == expected && into.data() == fixed.data());
+
+    //a buffer of exactly the text size is enough, whatever the estimates say
+    fixnum::OutputBuffer exact(fixed.data(), expected.size());
+    fixnum::format_many<N>(values, ',', exact);
+    assert(exact.str() == expected);
+
+    bool threw = false;
+    fixnum::OutputBuffer small(fixed.data(), expected.size() / 2);
+    try { fixnum::format_many<N>(values, ',', small); } catch(const std::overflow_error&) { threw = true; }
+    assert(threw);
+}
+
+void test_format() {
+    uint64_t state = 50;
+    check_format<8>(state);
+    check_format<12>(state);
+    check_format<16>(state);
+    check_format<32>(state);
+    check_format<64>(state);
+    check_format<65>(state);
+    check_format<128>(state);
+    check_format<300>(state);
+    check_format<1024>(state);
+
+    std::vector<Fixnum<128>> many;
+    for(int i = 0; i < 100000; ++i) {
+        many.push_back(random_fixnum<128>(state, 1 + (i % 127)));
+    }
+
+    fixnum::OutputBuffer serial;
+    fixnum::format_many<128>(many, '\n', serial);
+
+    fixnum::OutputBuffer threaded;
+    threaded.append("x,", 2);
+    fixnum::parallel_format_many<128>(many, '\n', threaded, 4);
+    assert(threaded.str() == "x," + serial.str());
+
+    fixnum::OutputBuffer empty;
+    fixnum::parallel_format_many<128>(fixnum::Span<const Fixnum<128>>(), ',', empty, 4);
+    assert(empty.empty());
+}
+
+void bench_format() {
+    using namespace std::chrono;
+    using bit128 = Fixnum<128>;
+
+    uint64_t state = 51;
+    std::vector<bit128> values;
+    for(int i = 0; i < 1000000; ++i) {
+        values.push_back(random_fixnum<128>(state));
+    }
+
+    //str() is slow enough that a tenth of the values makes the point
+    auto start = system_clock::now();
+    std::string appended;
+    for(size_t i = 0; i < values.size() / 10; ++i) {
+        appended += values[i].str();
+        appended += ',';
+    }
+    auto end = system_clock::now();
+    std::cout << "str() append (1/10): " << nanoseconds(end - start).count() << std::endl;
+
+    start = system_clock::now();
+    fixnum::OutputBuffer out;
+    fixnum::format_many<128>(values, ',', out);
+    end = system_clock::now();
+    std::cout << "format_many: " << out.size() << " " << nanoseconds(end - start).count() << std::endl;
+
+    start = system_clock::now();
+    fixnum::OutputBuffer threaded;
+    fixnum::parallel_format_many<128>(values, ',', threaded);
+    end = system_clock::now();
+    std::cout << "parallel_format_many: " << threaded.size() << " " << nanoseconds(end - start).count() << std::endl;
+    assert(std::memcmp(out.data(), appended.data(), appended.size()) == 0);
+}
+
+template<size_t N>
+void check_radix(uint64_t& state) {
+    using F = Fixnum<N>;
+    for(int i = 0; i < 40; ++i) {
+        const F f = random_fixnum<N>(state, 1 + (i * (N - 1) / 40));
+        const F n = f.complement();
+        for(int base = 2; base <= 36; ++base) {
+            assert(F(f.str(base), base) == f);
+            assert(F(n.str(base), base) == n);
+        }
+    }
+
+    assert(F(F::lowest().str(36), 36) == F::lowest());
+}
+
+void test_radix() {
+    using namespace decode;
+
+    //every base pair against plain 64 bit arithmetic
+    uint64_t state = 52;
+    for(int source = 2; source <= 36; ++source) {
+        for(int target = 2; target <= 36; ++target) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            uint64_t value = state >> (state % 64);
+            std::vector<uint8_t> digits;
+            for(uint64_t v = value; v != 0; v /= source) {
+                digits.insert(digits.begin(), static_cast<uint8_t>(v % source));
+            }
+
+            std::vector<uint8_t> expected;
+            for(uint64_t v = value; v != 0; v /= target) {
+                expected.insert(expected.begin(), static_cast<uint8_t>(v % target));
+            }
+
+            if(expected.empty()) {
+                expected.push_back(0);
+                digits.push_back(0);
+            }
+
+            digits.insert(digits.begin(), 3, 0);
+            assert(convert_base(digits, source, target) == expected);
+        }
+    }
+
+    assert(convert_base(std::vector<uint8_t>(), 10, 36).empty());
+    assert(convert_base(std::vector<uint8_t>(5, 0), 10, 36) == std::vector<uint8_t>(1, 0));
+    assert(to_char(35) == 'Z' && convert_char('z') == 35 && convert_char('A') == 10 && convert_char('a') == 10);
+
+    assert(Fixnum<64>(35).str(36) == "Z");
+    assert(Fixnum<64>(36).str(36) == "10");
+    assert(Fixnum<64>(-1295).str(36) == "-ZZ");
+    assert(Fixnum<64>("-zz", 36) == Fixnum<64>(-1295));
+    assert(Fixnum<32>(std::numeric_limits<int32_t>::max()).str(36) == "ZIK0ZJ");
+
+    bool threw = false;
+    try { Fixnum<64>(10).str(37); } catch(const std::invalid_argument&) { threw = true; }
+    assert(threw);
+
+    threw = false;
+    try { convert_base(std::vector<uint8_t>(1, 7), 10, 1); } catch(const std::invalid_argument&) { threw = true; }
+    assert(threw);
+
+    threw = false;
+    try { convert_base(std::vector<uint8_t>(1, 7), 7, 10); } catch(const std::invalid_argument&) { threw = true; }
+    assert(threw);
+
+    check_radix<8>(state);
+    check_radix<12>(state);
+    check_radix<16>(state);
+    check_radix<32>(state);
+    check_radix<64>(state);
+    check_radix<100>(state);
+    check_radix<256>(state);
+    check_radix<1024>(state);
+}
+
+void bench_radix() {
+    using namespace std::chrono;
+    using bit1024 = Fixnum<1024>;
+
+    uint64_t state = 53;
+    std::vector<bit1024> values;
+    for(int i = 0; i < 2000; ++i) {
+        values.push_back(random_fixnum<1024>(state));
+    }
+
+    for(const int base : { 2, 10, 16, 36 }) {
+        auto start = system_clock::now();
+        std::vector<std::string> text;
+        for(const bit1024& f : values) {
+            text.push_back(f.str(base));
+        }
+        auto end = system_clock::now();
+        std::cout << "str(" << base << "): " << nanoseconds(end - start).count() << std::endl;
+
+        start = system_clock::now();
+        std::vector<bit1024> parsed;
+        for(const std::string& s : text) {
+            parsed.push_back(bit1024(decode::ConvertBase<uint8_t>(s, base, 16)));
+        }
+        end = system_clock::now();
+        std::cout << "ConvertBase(" << base << "): " << nanoseconds(end - start).count() << std::endl;
+        assert(parsed == values);
+    }
+
+    std::vector<uint8_t> binary(1 << 16);
+    for(uint8_t& d : binary) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        d = static_cast<uint8_t>(state >> 63);
+    }
+
+    auto start = system_clock::now();
+    const std::vector<uint8_t> hex = decode::convert_base(binary, 2, 16);
+    auto end = system_clock::now();
+    std::cout << "convert_base 2 to 16: " << hex.size() << " " << nanoseconds(end - start).count() << std::endl;
+
+    start = system_clock::now();
+    const std::vector<uint8_t> decimal = decode::convert_base(hex, 16, 10);
+    end = system_clock::now();
+    std::cout << "convert_base 16 to 10: " << decimal.size() << " " << nanoseconds(end - start).count() << std::endl;
+    assert(decode::convert_base(decimal, 10, 2) == decode::convert_base(binary, 2, 2));
+}
+
+//the digits by operator/ and operator% the way ids used to be encoded
+template<size_t N>
+std::string divide_out_base58(Fixnum<N> f) {
+    const char* digits = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+    const Fixnum<N> radix(58);
+    std::string ret;
+    do {
+        ret.insert(ret.begin(), digits[static_cast<int>((f % radix).data()[0])]);
+        f = f / radix;
+    } while(f != Fixnum<N>(0));
+
+    return ret;
+}
+
+template<size_t N>
+void check_encoding(uint64_t& state) {
+    using F = Fixnum<N>;
+    std::vector<F> values = { F(0), F(1), F(-1), F::lowest(), F::max() };
+    for(int i = 0; i < 200; ++i) {
+        values.push_back(random_fixnum<N>(state, 1 + (i % (N - 1))));
+        values.push_back(values.back().complement());
+    }
+
+    for(const F& f : values) {
+        const std::string b58 = fixnum::to_base58(f);
+        const std::string b32 = fixnum::to_base32(f);
+        const std::string b64 = fixnum::to_base64(f);
+        assert(b58.size() <= fixnum::max_base58_size<N>());
+        assert(b32.size() <= fixnum::max_base32_size<N>());
+        assert(b64.size() <= fixnum::max_base64_size<N>());
+        assert(fixnum::from_base58<N>(b58) == f);
+        assert(fixnum::from_base32<N>(b32) == f);
+        assert(fixnum::from_base64<N>(b64) == f);
+        assert(fixnum::from_base58<N>("111" + b58) == f);
+
+        if(!f.is_negative()) {
+            assert(b58 == divide_out_base58(f));
+            std::string lower = b32;
+            std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+            assert(fixnum::from_base32<N>(lower) == f);
+        }
+    }
+
+    fixnum::OutputBuffer out;
+    fixnum::to_base58<N>(values, ' ', out);
+    std::vector<F> back(values.size());
+    assert(fixnum::from_base58<N>(out.data(), out.size(), ' ', back) == values.size() && back == values);
+
+    out.clear();
+    fixnum::to_base32<N>(values, '\n', out);
+    assert(fixnum::from_base32<N>(out.data(), out.size(), '\n', back) == values.size() && back == values);
+
+    out.clear();
+    fixnum::to_base64<N>(values, ',', out);
+    assert(fixnum::from_base64<N>(out.data(), out.size(), ',', back) == values.size() && back == values);
+
+    //a fixed buffer of exactly the text size is enough
+    std::vector<char> fixed(out.size());
+    fixnum::OutputBuffer exact(fixed.data(), fixed.size());
+    fixnum::to_base64<N>(values, ',', exact);
+    assert(exact.str() == out.str());
+
+    const std::vector<F> small_values = { F(1), F(2) };
+    char pair[3];
+    fixnum::OutputBuffer tight(pair, sizeof(pair));
+    fixnum::to_base58<N>(small_values, ',', tight);
+    assert(tight.str() == "2,3");
+
+    bool threw = false;
+    try { fixnum::from_base64<N>(out.data(), out.size(), ',', fixnum::Span<F>(back.data(), 3)); }
+    catch(const std::overflow_error&) { threw = true; }
+    assert(threw);
+
+    //one past the largest N bit pattern
+    threw = false;
+    try { fixnum::from_base32<N>(std::string(fixnum::max_base32_size<N>() + 1, 'Z')); }
+    catch(const std::overflow_error&) { threw = true; }
+    assert(threw);
+}
+
+void test_encoding() {
+    using bit64 = Fixnum<64>;
+    using bit128 = Fixnum<128>;
+
+    assert(fixnum::to_base58(bit64(0)) == "1");
+    assert(fixnum::to_base58(bit64(57)) == "z");
+    assert(fixnum::to_base58(bit64(58)) == "21");
+    assert(fixnum::to_base64(bit64(63)) == "_");
+    assert(fixnum::to_base64(bit64(64)) == "BA");
+    assert(fixnum::to_base32(bit128::max()) == "3" + std::string(25, 'Z'));
+    assert(fixnum::to_base32(bit128(-1)) == "7" + std::string(25, 'Z'));
+    assert(fixnum::from_base32<64>("1O") == bit64(32) && fixnum::from_base32<64>("iL") == bit64(33));
+
+    bool threw = false;
+    try { fixnum::from_base58<64>("10OI"); } catch(const std::invalid_argument&) { threw = true; }
+    assert(threw);
+
+    threw = false;
+    try { fixnum::from_base64<64>(""); } catch(const std::invalid_argument&) { threw = true; }
+    assert(threw);
+
+    uint64_t state = 54;
+    check_encoding<8>(state);
+    check_encoding<12>(state);
+    check_encoding<32>(state);
+    check_encoding<64>(state);
+    check_encoding<128>(state);
+    check_encoding<256>(state);
+    check_encoding<300>(state);
+}
+
+void bench_encoding() {
+    using namespace std::chrono;
+    using bit256 = Fixnum<256>;
+
+    uint64_t state = 55;
+    std::vector<bit256> ids;
+    for(int i = 0; i < 20000; ++i) {
+        ids.push_back(random_fixnum<256>(state));
+    }
+
+    //the division route is slow enough that a fiftieth of the ids makes the point
+    auto start = system_clock::now();
+    std::vector<std::string> divided;
+    for(size_t i = 0; i < ids.size() / 50; ++i) {
+        divided.push_back(divide_out_base58(ids[i]));
+    }
+    auto end = system_clock::now();
+    std::cout << "base58 by operator/ (1/50): " << nanoseconds(end - start).count() << std::endl;
+
+    start = system_clock::now();
+    std::vector<std::string> encoded;
+    for(const bit256& id : ids) {
+        encoded.push_back(fixnum::to_base58(id));
+    }
+    end = system_clock::now();
+    std::cout << "to_base58: " << nanoseconds(end - start).count() << std::endl;
+    assert(std::equal(divided.begin(), divided.end(), encoded.begin()));
+
+    start = system_clock::now();
+    fixnum::OutputBuffer out;
+    fixnum::to_base58<256>(ids, '\n', out);
+    end = system_clock::now();
+    std::cout << "to_base58 batch: " << out.size() << " " << nanoseconds(end - start).count() << std::endl;
+
+    start = system_clock::now();
+    std::vector<bit256> back(ids.size());
+    fixnum::from_base58<256>(out.data(), out.size(), '\n', back);
+    end = system_clock::now();
+    std::cout << "from_base58 batch: " << nanoseconds(end - start).count() << std::endl;
+    assert(back == ids);
+
+    start = system_clock::now();
+    out.clear();
+    fixnum::to_base32<256>(ids, '\n', out);
+    end = system_clock::now();
+    std::cout << "to_base32 batch: " << out.size() << " " << nanoseconds(end - start).count() << std::endl;
+}
+
+template<size_t N>
+void check_float(uint64_t& state) {
+    using F = Fixnum<N>;
+    std::vector<F> values = { F(0), F(1), F(-1), F::lowest(), F::max() };
+    for(int i = 0; i < 300; ++i) {
+        values.push_back(random_fixnum<N>(state, 1 + (i % (N - 1))));
+        values.push_back(values.back().complement());
+    }
+
+    //exact ties and values just either side of them
+    for(int shift = 0; shift + 56 < static_cast<int>(N); shift += 7) {
+        const F tie = (F(1) << (shift + 54)) + (F(1) << shift);
+        values.push_back(tie);
+        values.push_back(tie + F(1));
+        values.push_back(tie - F(1));
+        values.push_back(tie + (F(1) << (shift + 1)));
+    }
+
+    for(const F& f : values) {
+        const double d = fixnum::to_double(f);
+        assert(d == std::stod(f.str()));
+        assert(fixnum::to_long_double(f) == std::stold(f.str()));
+
+        //every double that comes out of a fixnum is whole and in range,
+        //except the ones that rounded up past the top
+        if(std::fabs(d) < std::ldexp(1.0, N - 1) || d == -std::ldexp(1.0, N - 1)) {
+            char text[400];
+            std::snprintf(text, sizeof(text), "%.0f", d);
+            assert(fixnum::from_double<N>(d) == F(text, 10));
+        }
+    }
+
+    assert(fixnum::from_double<N>(-std::ldexp(1.0, N - 1)) == F::lowest());
+    bool threw = false;
+    try { fixnum::from_double<N>(std::ldexp(1.0, N - 1)); } catch(const std::overflow_error&) { threw = true; }
+    assert(threw);
+}
+
+void test_float() {
+    using bit64 = Fixnum<64>;
+    assert(fixnum::to_double(bit64(-12345)) == -12345.0);
+    assert(fixnum::from_double<64>(-7.75, fixnum::FloatConversion::truncate) == bit64(-7));
+    assert(fixnum::from_double<64>(0.5, fixnum::FloatConversion::truncate) == bit64(0));
+    assert(fixnum::from_double<8>(-128.0) == Fixnum<8>(-128));
+
+    bool threw = false;
+    try { fixnum::from_double<64>(7.75); } catch(const std::invalid_argument&) { threw = true; }
+    assert(threw);
+
+    threw = false;
+    try { fixnum::from_double<64>(std::numeric_limits<double>::quiet_NaN()); } catch(const std::invalid_argument&) { threw = true; }
+    assert(threw);
+
+    threw = false;
+    try { fixnum::from_double<8>(128.0); } catch(const std::overflow_error&) { threw = true; }
+    assert(threw);
+
+    //past the top of double
+    assert(std::isinf(fixnum::to_double(Fixnum<2048>::max())));
+    assert(fixnum::to_double(Fixnum<2048>(1) << 1000) == std::ldexp(1.0, 1000));
+
+    uint64_t state = 56;
+    check_float<8>(state);
+    check_float<12>(state);
+    check_float<32>(state);
+    check_float<64>(state);
+    check_float<100>(state);
+    check_float<128>(state);
+    check_float<512>(state);
+    check_float<1000>(state);
+}
+
+void bench_float() {
+    using namespace std::chrono;
+    using bit512 = Fixnum<512>;
+
+    uint64_t state = 57;
+    std::vector<bit512> values;
+    for(int i = 0; i < 20000; ++i) {
+        values.push_back(random_fixnum<512>(state));
+    }
+
+    auto start = system_clock::now();
+    double parsed = 0;
+    for(const bit512& f : values) {
+        parsed += std::stod(f.str());
+    }
+    auto end = system_clock::now();
+    std::cout << "stod(str()): " << parsed << " " << nanoseconds(end - start).count() << std::endl;
+
+    start = system_clock::now();
+    double converted = 0;
+    for(const bit512& f : values) {
+        converted += fixnum::to_double(f);
+    }
+    end = system_clock::now();
+    std::cout << "to_double: " << converted << " " << nanoseconds(end - start).count() << std::endl;
+    assert(parsed == converted);
+}
+
+//Fixnum<64> against int64_t under the same flags, hex and oct only for
+//values where int prints the magnitude
+void check_stream_flags(const int64_t v, const std::ios_base::fmtflags flags, const int width) {
+    std::ostringstream expected;
+    expected.flags(flags);
+    expected.fill('*');
+    expected.width(width);
+    expected << v << '|';
+
+    std::ostringstream actual;
+    actual.flags(flags);
+    actual.fill('*');
+    actual.width(width);
+    actual << Fixnum<64>(v) << '|';
+    assert(actual.str() == expected.str());
+}
+
+void test_stream() {
+    const std::ios_base::fmtflags bases[] = { std::ios_base::dec, std::ios_base::hex, std::ios_base::oct };
+    const std::ios_base::fmtflags adjusts[] = { std::ios_base::left, std::ios_base::right, std::ios_base::internal };
+    const int64_t values[] = { 0, 1, 7, 8, 255, 4096, 123456789, std::numeric_limits<int64_t>::max(), -1, -255,
+                               std::numeric_limits<int64_t>::min() + 1 };
+    for(const int64_t v : values) {
+        for(const auto base : bases) {
+            for(const auto adjust : adjusts) {
+                for(int extra = 0; extra < 8; ++extra) {
+                    std::ios_base::fmtflags flags = base | adjust;
+                    if(extra & 1) flags |= std::ios_base::showbase;
+                    if(extra & 2) flags |= std::ios_base::uppercase;
+                    if(extra & 4) flags |= std::ios_base::showpos;
+                    if(v < 0 && base != std::ios_base::dec) continue;
+                    if((extra & 4) && base != std::ios_base::dec) continue;
+                    check_stream_flags(v, flags, 0);
+                    check_stream_flags(v, flags, 30);
+                }
+            }
+        }
+    }
+
+    //wide values match str(base), negatives as a sign and magnitude in every base
+    uint64_t state = 58;
+    for(int i = 0; i < 200; ++i) {
+        const Fixnum<512> f = random_fixnum<512>(state, 1 + (i % 511));
+        const Fixnum<512> n = f.complement();
+        std::ostringstream out;
+        out << f << ' ' << n << ' ' << std::hex << std::uppercase << f << ' ' << n << ' ' << std::oct << f;
+        assert(out.str() == f.str() + " " + n.str() + " " + f.str(16) + " " + n.str(16) + " " + f.str(8));
+
+        std::istringstream in(out.str());
+        Fixnum<512> a, b, c, d, e;
+        in >> a >> b >> std::hex >> c >> d >> std::oct >> e;
+        assert(a == f && b == n && c == f && d == n && e == f && in.eof() && !in.fail());
+    }
+
+    std::ostringstream lowest;
+    lowest << std::showbase << std::hex << std::nouppercase << Fixnum<12>::lowest();
+    assert(lowest.str() == "-0x800");
+
+    std::istringstream words("  -123 +45x ff 99999999999999999999 -");
+    Fixnum<64> a(7), b(7), c(7);
+    words >> a >> b;
+    assert(a == Fixnum<64>(-123) && b == Fixnum<64>(45) && !words.fail());
+    words >> c;
+    assert(words.fail() && c == Fixnum<64>(7));
+
+    words.clear();
+    words.ignore(1);
+    words >> std::hex >> c;
+    assert(c == Fixnum<64>(255));
+
+    Fixnum<64> big(7);
+    words >> std::dec >> big;
+    assert(words.fail() && big == Fixnum<64>(7));
+
+    words.clear();
+    Fixnum<64> sign_only(7);
+    words >> sign_only;
+    assert(words.fail() && words.eof() && sign_only == Fixnum<64>(7));
+
+#if defined(__cpp_lib_format)
+    //the same specs give the same text as they do for int64_t
+    const char* specs[] = { "{}", "{:+}", "{: }", "{:#x}", "{:#X}", "{:#o}", "{:#b}", "{:08}", "{:#010x}",
+                            "{:<08}", "{:*^12}", "{:>+9d}", "{:=^#12b}" };
+    for(const int64_t v : { int64_t(0), int64_t(5), int64_t(-255), int64_t(123456789) }) {
+        const Fixnum<64> f(v);
+        for(const char* spec : specs) {
+            assert(std::vformat(spec, std::make_format_args(f)) ==
+                   std::vformat(spec, std::make_format_args(v)));
+        }
+    }
+#endif
+}
+
+void bench_stream() {
+    using namespace std::chrono;
+    using bit256 = Fixnum<256>;
+
+    uint64_t state = 59;
+    std::vector<bit256> values;
+    for(int i = 0; i < 20000; ++i) {
+        values.push_back(random_fixnum<256>(state).complement());
+    }
+
+    auto start = system_clock::now();
+    std::ostringstream by_str;
+    for(const bit256& f : values) {
+        by_str << f.str() << '\n';
+    }
+    auto end = system_clock::now();
+    std::cout << "ostream << str(): " << nanoseconds(end - start).count() << std::endl;
+
+    start = system_clock::now();
+    std::ostringstream direct;
+    for(const bit256& f : values) {
+        direct << f << '\n';
+    }
+    end = system_clock::now();
+    std::cout << "ostream << fixnum: " << nanoseconds(end - start).count() << std::endl;
+    assert(by_str.str() == direct.str());
+
+    start = system_clock::now();
+    std::istringstream in(direct.str());
+    std::vector<bit256> back(values.size());
+    for(bit256& f : back) {
+        in >> f;
+    }
+    end = system_clock::now();
+    std::cout << "istream >> fixnum: " << nanoseconds(end - start).count() << std::endl;
+    assert(back == values);
+}
+
+template<size_t N>
+void check_atomic(uint64_t& state) {
+    using F = Fixnum<N>;
+    fixnum::AtomicFixnum<N> a;
+    F expected(0);
+    assert(a.load() == expected);
+
+    for(int i = 0; i < 200; ++i) {
+        const F f = random_fixnum<N>(state, 1 + (i % (N - 1)));
+        const F g = i % 2 == 0 ? f : f.complement();
+        switch(i % 5) {
+        case 0: assert(a.fetch_add(g) == expected); expected += g; break;
+        case 1: assert(a.fetch_sub(g) == expected); expected -= g; break;
+        case 2: assert(a.fetch_or(f) == expected); expected |= f; break;
+        case 3: assert(a.exchange(g) == expected); expected = g; break;
+        case 4: a.store(g); expected = g; break;
+        }
+
+        assert(a.load() == expected);
+    }
+
+    F wrong = expected + F(1);
+    assert(!a.compare_exchange(wrong, F(5)) && wrong == expected);
+    assert(a.compare_exchange(wrong, F(5)) && a.load() == F(5));
+
+    //wrapping keeps the bits above N clear
+    a.store(F::max());
+    assert(a.fetch_add(F(1)) == F::max() && a.load() == F::lowest());
+    assert(a.fetch_sub(F(1)) == F::lowest() && a.load() == F::max());
+
+    //every thread adds and ors in its own bit, nothing may be lost
+    a.store(F(0));
+    const unsigned threads = 4;
+    fixnum::run_threads(threads, [&](const unsigned) {
+        for(int i = 0; i < 5000; ++i) {
+            a.fetch_add(F(3));
+            a.fetch_sub(F(1));
+        }
+    });
+    F sum(0);
+    for(unsigned i = 0; i < 5000 * threads; ++i) {
+        sum += F(2);
+    }
+    assert(a.load() == sum);
+
+    a.store(F(0));
+    fixnum::run_threads(threads, [&](const unsigned t) {
+        a.fetch_or(F(1) << static_cast<int>(N - 1 - t));
+    });
+    F bits(0);
+    for(unsigned t = 0; t < threads; ++t) {
+        bits |= F(1) << static_cast<int>(N - 1 - t);
+    }
+    assert(a.load() == bits);
+}
+
+void test_atomic() {
+    assert(fixnum::AtomicFixnum<64>::is_always_lock_free);
+    assert(fixnum::AtomicFixnum<12>::is_always_lock_free);
+#if FIXNUM_HAS_CAS16
+    assert(fixnum::AtomicFixnum<128>::is_always_lock_free);
+#endif
+    assert(!fixnum::AtomicFixnum<256>::is_always_lock_free);
+
+    uint64_t state = 60;
+    check_atomic<8>(state);
+    check_atomic<12>(state);
+    check_atomic<16>(state);
+    check_atomic<24>(state);
+    check_atomic<32>(state);
+    check_atomic<64>(state);
+    check_atomic<100>(state);
+    check_atomic<128>(state);
+    check_atomic<256>(state);
+    check_atomic<300>(state);
+}
+
+template<size_t N>
+void bench_atomic_width(const unsigned threads, const int total) {
+    using namespace std::chrono;
+    using F = Fixnum<N>;
+    const int each = total / threads;
+
+    std::mutex lock;
+    F locked(0);
+    auto start = system_clock::now();
+    fixnum::run_threads(threads, [&](const unsigned) {
+        for(int i = 0; i < each; ++i) {
+            std::lock_guard<std::mutex> guard(lock);
+            locked += F(1);
+        }
+    });
+    auto end = system_clock::now();
+    const auto mutex_time = nanoseconds(end - start).count();
+
+    fixnum::AtomicFixnum<N> counter;
+    start = system_clock::now();
+    fixnum::run_threads(threads, [&](const unsigned) {
+        for(int i = 0; i < each; ++i) {
+            counter.fetch_add(F(1));
+        }
+    });
+    end = system_clock::now();
+    std::cout << "atomic " << N << " x" << threads << ": mutex " << mutex_time
+              << " atomic " << nanoseconds(end - start).count() << std::endl;
+    assert(locked == counter.load());
+}
+
+void bench_atomic() {
+    for(const unsigned threads : { 1u, 2u, 4u, 8u, 16u, 32u, 64u }) {
+        bench_atomic_width<64>(threads, 1 << 19);
+        bench_atomic_width<128>(threads, 1 << 19);
+        bench_atomic_width<256>(threads, 1 << 19);
+    }
+}
+
+template<size_t N>
+void check_sharded(uint64_t& state) {
+    using F = Fixnum<N>;
+    using Wide = typename fixnum::ShardedFixnumCounter<N>::Wide;
+    fixnum::ShardedFixnumCounter<N> counter(3);
+    assert(counter.shard_count() == 3 && counter.load() == F(0));
+
+    //F::max() added past the point where Fixnum<N> would wrap
+    std::vector<F> adds;
+    for(int i = 0; i < 64; ++i) {
+        adds.push_back(i % 4 == 0 ? F::max() : random_fixnum<N>(state, 1 + (i % (N - 1))));
+    }
+
+    const unsigned threads = 6;
+    fixnum::run_threads(threads, [&](const unsigned t) {
+        for(const F& f : adds) {
+            counter.add(f);
+            if(t % 2 == 1) {
+                counter.sub(f);
+                counter.sub(F::lowest());
+            }
+        }
+    });
+
+    F wrapped(0);
+    Wide exact(0);
+    for(unsigned t = 0; t < threads; ++t) {
+        for(const F& f : adds) {
+            wrapped += f;
+            exact += fixnum_cast<N + 64>(f);
+            if(t % 2 == 1) {
+                wrapped -= f;
+                wrapped -= F::lowest();
+                exact -= fixnum_cast<N + 64>(f);
+                exact -= fixnum_cast<N + 64>(F::lowest());
+            }
+        }
+    }
+
+    assert(counter.load() == wrapped);
+    assert(counter.wide_load() == exact);
+    assert(exact.is_negative() == false);
+    assert(counter.take() == exact);
+    assert(counter.wide_load() == Wide(0));
+
+    counter.add(F(-5));
+    assert(counter.take() == Wide(-5) && counter.load() == F(0));
+}
+
+void test_sharded() {
+    //nothing the counter does depends on the cast being right, the test does
+    assert(fixnum_cast<76>(Fixnum<12>(-3)) == Fixnum<76>(-3));
+    assert(fixnum_cast<320>(Fixnum<256>::lowest()) == -fixnum_cast<320>(Fixnum<256>::max()) - Fixnum<320>(1));
+
+    uint64_t state = 61;
+    check_sharded<8>(state);
+    check_sharded<12>(state);
+    check_sharded<64>(state);
+    check_sharded<128>(state);
+    check_sharded<256>(state);
+}
+
+void bench_sharded() {
+    using namespace std::chrono;
+    using bit256 = Fixnum<256>;
+    const int total = 1 << 19;
+
+    for(const unsigned threads : { 1u, 4u, 16u, 64u }) {
+        const int each = total / threads;
+        fixnum::AtomicFixnum<256> single;
+        auto start = system_clock::now();
+        fixnum::run_threads(threads, [&](const unsigned) {
+            for(int i = 0; i < each; ++i) {
+                single.fetch_add(bit256(1));
+            }
+        });
+        auto end = system_clock::now();
+        const auto single_time = nanoseconds(end - start).count();
+
+        //a shard per adding thread, the case the counter is built for
+        fixnum::ShardedFixnumCounter<256> sharded(threads);
+        start = system_clock::now();
+        fixnum::run_threads(threads, [&](const unsigned) {
+            for(int i = 0; i < each; ++i) {
+                sharded.add(bit256(1));
+            }
+        });
+        end = system_clock::now();
+        std::cout << "sharded 256 x" << threads << ": atomic " << single_time
+                  << " sharded " << nanoseconds(end - start).count() << std::endl;
+        assert(sharded.load() == single.load());
+    }
+}
+
+template<size_t N>
+void check_accumulator(uint64_t& state) {
+    using F = Fixnum<N>;
+    using W = Fixnum<N + 64>;
+    fixnum::FixnumAccumulator<N> sum;
+    fixnum::FixnumAccumulator<N> other;
+    fixnum::FixnumAccumulator<N, 3> narrow;
+    W expected(0);
+    W other_expected(0);
+    W narrow_expected(0);
+    assert(sum.result() == W(0));
+
+    for(int i = 0; i < 3000; ++i) {
+        F f = i % 7 == 0 ? F::max() : i % 11 == 0 ? F::lowest() : random_fixnum<N>(state, 1 + (i % (N - 1)));
+        if(i % 3 == 0) {
+            f = -f;
+        }
+
+        if(i % 4 == 0) {
+            other += f;
+            other_expected += fixnum_cast<N + 64>(f);
+        }
+        else {
+            sum.add(f);
+            expected += fixnum_cast<N + 64>(f);
+        }
+
+        narrow.add(f);
+        narrow_expected += fixnum_cast<N + 64>(f);
+    }
+
+    assert(sum.result() == expected);
+    assert(other.result() == other_expected);
+
+    //three bits of headroom wrap where the wide sum does not
+    Fixnum<N + 3> wrapped;
+    std::memcpy(wrapped.data(), narrow_expected.data(), Fixnum<N + 3>::bytes);
+    wrapped.data()[Fixnum<N + 3>::top_index] &= Fixnum<N + 3>::top_mask;
+    assert(narrow.result() == wrapped);
+
+    sum.merge(other);
+    assert(sum.result() == expected + other_expected && sum.count() == 3000);
+
+    std::vector<F> values(100, F::lowest());
+    fixnum::FixnumAccumulator<N> span_sum;
+    span_sum.add(values);
+    assert(span_sum.result() == fixnum_cast<N + 64>(F::lowest()) * W(100));
+
+    span_sum.reset();
+    assert(span_sum.result() == W(0) && span_sum.count() == 0);
+}
+
+void test_accumulator() {
+    uint64_t state = 62;
+    check_accumulator<8>(state);
+    check_accumulator<12>(state);
+    check_accumulator<32>(state);
+    check_accumulator<64>(state);
+    check_accumulator<100>(state);
+    check_accumulator<128>(state);
+    check_accumulator<256>(state);
+}
+
+void bench_accumulator() {
+    using namespace std::chrono;
+    using bit128 = Fixnum<128>;
+    using bit192 = Fixnum<192>;
+
+    uint64_t state = 63;
+    std::vector<bit128> values;
+    for(int i = 0; i < 1000000; ++i) {
+        values.push_back(i % 2 == 0 ? random_fixnum<128>(state) : -random_fixnum<128>(state));
+    }
+
+    auto start = system_clock::now();
+    bit192 wide(0);
+    for(const bit128& f : values) {
+        wide += fixnum_cast<192>(f);
+    }
+    auto end = system_clock::now();
+    std::cout << "sum by operator+=: " << nanoseconds(end - start).count() << std::endl;
+
+    start = system_clock::now();
+    fixnum::FixnumAccumulator<128> sum;
+    sum.add(values);
+    const bit192 total = sum.result();
+    end = system_clock::now();
+    std::cout << "FixnumAccumulator: " << nanoseconds(end - start).count() << std::endl;
+    assert(total == wide);
+}
+
+template<size_t N, typename S>
+void check_storage(uint64_t& state) {
+    using F = Fixnum<N>;
+    using A = Fixnum<N, S>;
+
+    static_assert(A::bytes == F::bytes, "storage must not change the value size");
+    static_assert(sizeof(A) == A::storage_bytes && sizeof(A) % S::alignment == 0, "storage size");
+    static_assert(alignof(A) == S::alignment, "storage alignment");
+
+    for(int i = 0; i < 200; ++i) {
+        const F one = i % 3 == 0 ? -random_fixnum<N>(state) : random_fixnum<N>(state);
+        const F two = random_fixnum<N>(state);
+        const A a = storage_cast<S>(one);
+        const A b = storage_cast<S>(two);
+
+        assert(storage_cast<PackedStorage>(a) == one);
+        assert(a.str() == one.str() && a.str(16) == one.str(16));
+        assert(storage_cast<PackedStorage>(a + b) == one + two);
+        assert(storage_cast<PackedStorage>(a - b) == one - two);
+        assert(storage_cast<PackedStorage>(a * b) == one * two);
+        assert(storage_cast<PackedStorage>(a ^ b) == (one ^ two));
+        assert(storage_cast<PackedStorage>(a + 7) == one + 7);
+        assert((a < b) == (one < two) && (a == b) == (one == two));
+        if(two != F(0)) {
+            assert(storage_cast<PackedStorage>(a / b) == one / two);
+        }
+
+        //padding past the value stays zero through the arithmetic
+        const A c = a * b - a;
+        for(size_t j = A::bytes; j < A::storage_bytes; ++j) {
+            assert(c.data()[j] == 0);
+        }
+    }
+
+    assert(A(A::max().str(), 10) == A::max());
+    assert(fixnum_cast<N + 8>(storage_cast<S>(F::lowest())) == fixnum_cast<N + 8>(F::lowest()));
+}
+
+void test_storage() {
+    //the default keeps the packed layout
+    static_assert(sizeof(Fixnum<40>) == 5 && alignof(Fixnum<40>) == 1, "packed layout");
+    static_assert(sizeof(Fixnum<256>) == 32 && alignof(Fixnum<256>) == 1, "packed layout");
+    static_assert(std::is_same<Fixnum<256>, Fixnum<256, PackedStorage>>::value, "packed default");
+    static_assert(sizeof(Fixnum<40, LimbStorage>) == 8 && alignof(Fixnum<40, LimbStorage>) == 8, "limb layout");
+    static_assert(sizeof(Fixnum<256, AlignedStorage<64>>) == 64, "aligned layout");
+    static_assert(sizeof(Fixnum<520, AlignedStorage<32>>) == 96, "aligned layout");
+
+    uint64_t state = 64;
+    check_storage<40, LimbStorage>(state);
+    check_storage<100, LimbStorage>(state);
+    check_storage<256, LimbStorage>(state);
+    check_storage<64, AlignedStorage<32>>(state);
+    check_storage<128, AlignedStorage<32>>(state);
+    check_storage<256, AlignedStorage<32>>(state);
+    check_storage<256, AlignedStorage<64>>(state);
+    check_storage<520, AlignedStorage<64>>(state);
+
+    fixnum::AlignedFixnumVector<256> aligned;
+    for(int i = 0; i < 100; ++i) {
+        aligned.push_back(Fixnum<256, AlignedStorage<64>>(i));
+        for(const auto& f : aligned) {
+            assert(fixnum::is_aligned(&f, fixnum::cache_line));
+        }
+    }
+
+    std::vector<Fixnum<256>, fixnum::CacheLineAllocator<Fixnum<256>>> packed(1001);
+    assert(fixnum::is_aligned(packed.data(), fixnum::cache_line));
+    std::vector<uint8_t, fixnum::CacheLineAllocator<uint8_t, 4096>> page(3);
+    assert(fixnum::is_aligned(page.data(), 4096));
+}
+
+void bench_storage() {
+    using namespace std::chrono;
+    using Packed = Fixnum<256>;
+    using Aligned = Fixnum<256, AlignedStorage<32>>;
+
+    uint64_t state = 65;
+    std::vector<Packed> values;
+    for(int i = 0; i < 200000; ++i) {
+        values.push_back(random_fixnum<256>(state));
+    }
+
+    std::vector<Aligned, fixnum::CacheLineAllocator<Aligned>> aligned;
+    for(const Packed& f : values) {
+        aligned.push_back(storage_cast<AlignedStorage<32>>(f));
+    }
+
+    auto start = system_clock::now();
+    Packed packed_sum(0);
+    for(int round = 0; round < 10; ++round) {
+        for(const Packed& f : values) {
+            packed_sum += f;
+        }
+    }
+    auto end = system_clock::now();
+    std::cout << "packed Fixnum<256> add: " << nanoseconds(end - start).count() << std::endl;
+
+    start = system_clock::now();
+    Aligned aligned_sum(0);
+    for(int round = 0; round < 10; ++round) {
+        for(const Aligned& f : aligned) {
+            aligned_sum += f;
+        }
+    }
+    end = system_clock::now();
+    std::cout << "aligned Fixnum<256> add: " << nanoseconds(end - start).count() << std::endl;
+    assert(storage_cast<PackedStorage>(aligned_sum) == packed_sum);
+}
+
+void bench_radix_sort() {
+    using namespace std::chrono;
+    using bit128 = Fixnum<128>;
+
+    uint64_t state = 34;
+    const std::vector<bit128> keys = random_signed_keys<128>(state, 1 << 20);
+
+    std::vector<bit128> by_std = keys;
+    auto start = system_clock::now();
+    std::sort(by_std.begin(), by_std.end());
+    auto end = system_clock::now();
+    std::cout << "std::sort: " << nanoseconds(end - start).count() << std::endl;
+
+    std::vector<bit128> by_radix = keys;
+    start = system_clock::now();
+    fixnum::radix_sort(fixnum::make_span(by_radix));
+    end = system_clock::now();
+    std::cout << "radix_sort: " << nanoseconds(end - start).count() << std::endl;
+
+    std::vector<bit128> by_parallel = keys;
+    start = system_clock::now();
+    fixnum::parallel_radix_sort(fixnum::make_span(by_parallel));
+    end = system_clock::now();
+    std::cout << "parallel_radix_sort: " << nanoseconds(end - start).count() << std::endl;
+
+    assert(by_std == by_radix && by_radix == by_parallel);
+}
+
+void bench_factorial() {
+    using namespace std::chrono;
+
+    auto start = system_clock::now();
+    Fixnum<4096> folded(1);
+    for(int i = 2; i <= 600; ++i) {
+        folded *= Fixnum<4096>(i);
+    }
+    auto end = system_clock::now();
+    std::cout << "factorial fold: " << nanoseconds(end - start).count() << std::endl;
+
+    start = system_clock::now();
+    Fixnum<4096> tree = fixnum::factorial<4096>(600, 1);
+    end = system_clock::now();
+    std::cout << "factorial tree: " << nanoseconds(end - start).count() << std::endl;
+
+    start = system_clock::now();
+    Fixnum<4096> threaded = fixnum::factorial<4096>(600);
+    end = system_clock::now();
+    std::cout << "factorial tree threaded: " << nanoseconds(end - start).count() << std::endl;
+
+    assert(folded == tree && tree == threaded);
+}
+
 int main(int argc, char* argv[]) {
 
     using namespace decode;
@@ -738,6 +3288,53 @@ int main(int argc, char* argv[]) {
 
     test_large_numbers();
     test_int_adds();
+    test_product_tree();
+    test_gcd();
+    test_pow();
+    test_roots();
+    test_hash();
+    test_radix_sort();
+    test_sortable_keys();
+    test_byte_order();
+    test_fixnum_view();
+    test_fixnum_file();
+    test_varint();
+    test_fixnum_column();
+    test_packed_array();
+    test_fixnum_parser();
+    test_digit_kernels();
+    test_hex();
+    test_format();
+    test_radix();
+    test_encoding();
+    test_float();
+    test_stream();
+    test_atomic();
+    test_sharded();
+    test_accumulator();
+    test_storage();
+
+    bench_factorial();
+    bench_gcd();
+    bench_pow_mod();
+    bench_roots();
+    bench_hash();
+    bench_radix_sort();
+    bench_fixnum_file();
+    bench_varint();
+    bench_fixnum_column();
+    bench_packed_array();
+    bench_decimal_parse();
+    bench_hex();
+    bench_format();
+    bench_radix();
+    bench_encoding();
+    bench_float();
+    bench_stream();
+    bench_atomic();
+    bench_sharded();
+    bench_accumulator();
+    bench_storage();
 
     auto start = system_clock::now();
     int target = 0;